@@ -0,0 +1,277 @@
+/*
+ * SPDX-FileCopyrightText: 2026 CSC - IT Center for Science Ltd. <www.csc.fi>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/*
+ * Benchmark harness shared by the C and C++ examples
+ *
+ * A benchmark is run bench_total_runs() times. The first `warmup` timings
+ * given to bench_add() are discarded and the remaining `reps` are used for
+ * the statistics (min, median, mean, standard deviation and 95% confidence
+ * interval of the mean).
+ *
+ * The defaults given by the program can be overridden with the environment
+ * variables BENCH_WARMUP and BENCH_REPS. If BENCH_OUTPUT is set, every
+ * bench_report() appends one record to that file, in CSV format if the
+ * filename ends with .csv and as JSON lines otherwise. All the programs use
+ * the same fields, so the files can be concatenated and compared between
+ * builds.
+ *
+ * Typical use:
+ *
+ *     bench_t b;
+ *     bench_init(&b, "heat", "n=1024 niter=500", 1, 5);
+ *     for (int r = 0; r < bench_total_runs(&b); r++) {
+ *         double t0 = bench_time();
+ *         kernel();
+ *         bench_add(&b, bench_time() - t0);
+ *     }
+ *     bench_stats_t s = bench_report(&b, 1.0e-9 * bytes, "GB/s");
+ *     bench_print(&b, &s);
+ *     bench_free(&b);
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+typedef struct {
+    char name[64];
+    char config[256];
+    int warmup;
+    int reps;
+    int nrun;        // number of bench_add() calls so far
+    int nsample;     // number of timings kept
+    double *samples;
+} bench_t;
+
+typedef struct {
+    int n;
+    double min;
+    double median;
+    double mean;
+    double stddev;
+    double ci95_low;
+    double ci95_high;
+    double work;        // amount of work per run, in units of `unit` * s
+    const char *unit;
+    double throughput;  // work / median
+} bench_stats_t;
+
+
+static inline
+double bench_time(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + 1.0e-9 * ts.tv_nsec;
+}
+
+
+static inline
+int bench_env_int(const char *name, const int fallback)
+{
+    const char *env = getenv(name);
+    if (env == NULL || *env == '\0') return fallback;
+    int value = atoi(env);
+    return value < 0 ? fallback : value;
+}
+
+
+static inline
+void bench_init(bench_t *b, const char *name, const char *config, const int warmup, const int reps)
+{
+    snprintf(b->name, sizeof(b->name), "%s", name);
+    snprintf(b->config, sizeof(b->config), "%s", config);
+    b->warmup = bench_env_int("BENCH_WARMUP", warmup);
+    b->reps = bench_env_int("BENCH_REPS", reps);
+    if (b->reps < 1) b->reps = 1;
+    b->nrun = 0;
+    b->nsample = 0;
+    b->samples = (double*)malloc(b->reps * sizeof(double));
+}
+
+
+static inline
+void bench_free(bench_t *b)
+{
+    free(b->samples);
+    b->samples = NULL;
+}
+
+
+static inline
+int bench_total_runs(const bench_t *b)
+{
+    return b->warmup + b->reps;
+}
+
+
+static inline
+void bench_add(bench_t *b, const double seconds)
+{
+    if (b->nrun++ < b->warmup) return;
+    if (b->nsample < b->reps) b->samples[b->nsample++] = seconds;
+}
+
+
+static inline
+int bench_compare(const void *a, const void *b)
+{
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+
+// Two-sided 95% quantile of Student's t distribution
+static inline
+double bench_t95(const int dof)
+{
+    static const double table[] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+    };
+    if (dof < 1) return 0.0;
+    if (dof <= 30) return table[dof - 1];
+    if (dof <= 60) return 2.000;
+    if (dof <= 120) return 1.980;
+    return 1.960;
+}
+
+
+static inline
+bench_stats_t bench_stats(const bench_t *b)
+{
+    bench_stats_t s;
+    memset(&s, 0, sizeof(s));
+    s.n = b->nsample;
+    s.unit = "";
+    if (s.n == 0) return s;
+
+    double *sorted = (double*)malloc(s.n * sizeof(double));
+    memcpy(sorted, b->samples, s.n * sizeof(double));
+    qsort(sorted, s.n, sizeof(double), bench_compare);
+
+    s.min = sorted[0];
+    s.median = (s.n % 2) ? sorted[s.n / 2] : 0.5 * (sorted[s.n / 2 - 1] + sorted[s.n / 2]);
+
+    double sum = 0.0;
+    for (int i = 0; i < s.n; i++) sum += sorted[i];
+    s.mean = sum / s.n;
+
+    double sum2 = 0.0;
+    for (int i = 0; i < s.n; i++) sum2 += (sorted[i] - s.mean) * (sorted[i] - s.mean);
+    s.stddev = s.n > 1 ? sqrt(sum2 / (s.n - 1)) : 0.0;
+
+    double half_width = bench_t95(s.n - 1) * s.stddev / sqrt((double)s.n);
+    s.ci95_low = s.mean - half_width;
+    s.ci95_high = s.mean + half_width;
+
+    free(sorted);
+    return s;
+}
+
+
+static inline
+void bench_compiler(char *buffer, const size_t size)
+{
+#if defined(__NVCOMPILER)
+    snprintf(buffer, size, "nvhpc %d.%d", __NVCOMPILER_MAJOR__, __NVCOMPILER_MINOR__);
+#elif defined(__INTEL_LLVM_COMPILER)
+    snprintf(buffer, size, "icx %d", __INTEL_LLVM_COMPILER);
+#elif defined(__clang__)
+    snprintf(buffer, size, "clang %s", __clang_version__);
+#elif defined(__GNUC__)
+    snprintf(buffer, size, "gcc %d.%d.%d", __GNUC__, __GNUC_MINOR__, __GNUC_PATCHLEVEL__);
+#else
+    snprintf(buffer, size, "unknown");
+#endif
+    // Keep the field safe for both CSV and JSON
+    for (char *c = buffer; *c; c++) {
+        if (*c == '"' || *c == ',' || *c == '\\' || *c == '\n') *c = ' ';
+    }
+}
+
+
+static inline
+void bench_write(const bench_t *b, const bench_stats_t *s)
+{
+    const char *filename = getenv("BENCH_OUTPUT");
+    if (filename == NULL || *filename == '\0') return;
+
+    const size_t len = strlen(filename);
+    const int csv = len > 4 && strcmp(filename + len - 4, ".csv") == 0;
+
+    FILE *check = fopen(filename, "r");
+    const int is_new = check == NULL;
+    if (check) fclose(check);
+
+    FILE *file = fopen(filename, "a");
+    if (file == NULL) {
+        perror("Failed to open benchmark output file");
+        return;
+    }
+
+    char compiler[128];
+    bench_compiler(compiler, sizeof(compiler));
+
+    if (csv) {
+        if (is_new) {
+            fprintf(file, "benchmark,config,compiler,warmup,reps,min_s,median_s,mean_s,stddev_s,"
+                          "ci95_low_s,ci95_high_s,work,unit,throughput\n");
+        }
+        fprintf(file, "%s,\"%s\",%s,%d,%d,%.6e,%.6e,%.6e,%.6e,%.6e,%.6e,%.6e,%s,%.6e\n",
+                b->name, b->config, compiler, b->warmup, s->n,
+                s->min, s->median, s->mean, s->stddev, s->ci95_low, s->ci95_high,
+                s->work, s->unit, s->throughput);
+    } else {
+        fprintf(file, "{\"benchmark\": \"%s\", \"config\": \"%s\", \"compiler\": \"%s\", "
+                      "\"warmup\": %d, \"reps\": %d, "
+                      "\"min_s\": %.6e, \"median_s\": %.6e, \"mean_s\": %.6e, \"stddev_s\": %.6e, "
+                      "\"ci95_low_s\": %.6e, \"ci95_high_s\": %.6e, "
+                      "\"work\": %.6e, \"unit\": \"%s\", \"throughput\": %.6e}\n",
+                b->name, b->config, compiler, b->warmup, s->n,
+                s->min, s->median, s->mean, s->stddev, s->ci95_low, s->ci95_high,
+                s->work, s->unit, s->throughput);
+    }
+
+    fclose(file);
+}
+
+
+// Statistics of the collected timings; `work` is the amount of work done
+// in one run such that work / time is the throughput in `unit`
+// (e.g. 1.0e-9 * bytes and "GB/s"). The result is also written to the
+// BENCH_OUTPUT file if requested.
+static inline
+bench_stats_t bench_report(const bench_t *b, const double work, const char *unit)
+{
+    bench_stats_t s = bench_stats(b);
+    s.work = work;
+    s.unit = unit;
+    s.throughput = s.median > 0.0 ? work / s.median : 0.0;
+    bench_write(b, &s);
+    return s;
+}
+
+
+static inline
+void bench_print(const bench_t *b, const bench_stats_t *s)
+{
+    printf("Benchmark %s (%s): %d warm-up + %d timed runs\n", b->name, b->config, b->warmup, s->n);
+    printf("  min %.4e s, median %.4e s, mean %.4e s +- %.4e s (95%% CI %.4e ... %.4e s)\n",
+           s->min, s->median, s->mean, s->stddev, s->ci95_low, s->ci95_high);
+    if (s->work > 0.0) {
+        printf("  throughput (median) %.4f %s\n", s->throughput, s->unit);
+    }
+}
+
+#endif
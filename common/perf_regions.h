@@ -0,0 +1,212 @@
+/*
+ * SPDX-FileCopyrightText: 2026 CSC - IT Center for Science Ltd. <www.csc.fi>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/*
+ * Hardware performance counters for named code regions (Linux only)
+ *
+ * Compile with -DPERF_COUNTERS to enable, otherwise the macros are empty:
+ *
+ *     PERF_REGION_BEGIN("evolve");
+ *     evolve(...);
+ *     PERF_REGION_END("evolve", ncells);
+ *
+ * Cycles, instructions and last-level cache misses are counted with
+ * perf_event_open for the whole process, including threads created after
+ * program start (e.g. OpenMP or Kokkos host threads). A table of the totals
+ * per region is printed at exit, together with the derived cycles per cell
+ * and memory traffic per cell (LLC misses x cache line size / cells).
+ *
+ * Note! Only the host is measured. When offloading to a GPU, the counts
+ * show the cost of launching and waiting, not of the kernel itself.
+ *
+ * Counting may be restricted by /proc/sys/kernel/perf_event_paranoid;
+ * if the counters cannot be opened, only the time is reported.
+ */
+
+#ifndef PERF_REGIONS_H
+#define PERF_REGIONS_H
+
+#if defined(PERF_COUNTERS)
+
+#include <linux/perf_event.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#define PERF_REGION_BEGIN(name)      perf_region_begin(name)
+#define PERF_REGION_END(name, cells) perf_region_end(name, cells)
+
+#define PERF_NCOUNTER 3
+#define PERF_MAX_REGIONS 128
+
+typedef struct {
+    char name[256];
+    long calls;
+    double cells;
+    double seconds;
+    uint64_t counts[PERF_NCOUNTER];
+    // Values at the beginning of the open region
+    double start_time;
+    uint64_t start_counts[PERF_NCOUNTER];
+} perf_region_t;
+
+// The state is shared between all translation units including this header
+__attribute__((weak)) int perf_fd[PERF_NCOUNTER] = {-1, -1, -1};
+__attribute__((weak)) int perf_initialized = 0;
+__attribute__((weak)) int perf_nregion = 0;
+__attribute__((weak)) perf_region_t perf_regions[PERF_MAX_REGIONS];
+
+
+static inline
+double perf_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + 1.0e-9 * ts.tv_nsec;
+}
+
+
+static inline
+int perf_open(const uint64_t config)
+{
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    // Count also in the threads created later
+    attr.inherit = 1;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+
+static inline
+uint64_t perf_read(const int fd)
+{
+    uint64_t value = 0;
+    if (fd < 0 || read(fd, &value, sizeof(value)) != sizeof(value)) return 0;
+    return value;
+}
+
+
+static inline
+void perf_report(void)
+{
+    const double line_size = sysconf(_SC_LEVEL1_DCACHE_LINESIZE) > 0
+                           ? (double)sysconf(_SC_LEVEL1_DCACHE_LINESIZE) : 64.0;
+    const int counting = perf_fd[0] >= 0;
+
+    printf("Hardware counters per region%s:\n",
+           counting ? "" : " (counters not available, only time is measured)");
+    printf("  %-48s %8s %10s %12s %12s %6s %12s %10s %11s\n",
+           "region", "calls", "time (s)", "cycles", "instructions", "IPC",
+           "LLC misses", "cycles/cell", "bytes/cell");
+    for (int r = 0; r < perf_nregion; r++) {
+        const perf_region_t *p = &perf_regions[r];
+        const double cycles = (double)p->counts[0];
+        const double instructions = (double)p->counts[1];
+        const double misses = (double)p->counts[2];
+        printf("  %-48s %8ld %10.4f %12.4e %12.4e %6.2f %12.4e %10.3f %11.3f\n",
+               p->name, p->calls, p->seconds, cycles, instructions,
+               cycles > 0.0 ? instructions / cycles : 0.0, misses,
+               p->cells > 0.0 ? cycles / p->cells : 0.0,
+               p->cells > 0.0 ? line_size * misses / p->cells : 0.0);
+    }
+
+    for (int c = 0; c < PERF_NCOUNTER; c++) {
+        if (perf_fd[c] >= 0) close(perf_fd[c]);
+    }
+}
+
+
+// Open the counters before main() so that all the threads are inherited
+__attribute__((constructor)) static
+void perf_init(void)
+{
+    if (perf_initialized) return;
+    perf_initialized = 1;
+
+    const uint64_t configs[PERF_NCOUNTER] = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES,  // last-level cache on most CPUs
+    };
+    for (int c = 0; c < PERF_NCOUNTER; c++) {
+        perf_fd[c] = perf_open(configs[c]);
+        if (perf_fd[c] < 0) {
+            perror("perf_event_open");
+            for (int i = 0; i < c; i++) {
+                close(perf_fd[i]);
+                perf_fd[i] = -1;
+            }
+            break;
+        }
+    }
+
+    atexit(perf_report);
+}
+
+
+static inline
+perf_region_t *perf_region(const char *name)
+{
+    for (int r = 0; r < perf_nregion; r++) {
+        if (strcmp(perf_regions[r].name, name) == 0) return &perf_regions[r];
+    }
+    if (perf_nregion == PERF_MAX_REGIONS) return NULL;
+    perf_region_t *p = &perf_regions[perf_nregion++];
+    memset(p, 0, sizeof(*p));
+    snprintf(p->name, sizeof(p->name), "%s", name);
+    return p;
+}
+
+
+static inline
+void perf_region_begin(const char *name)
+{
+    perf_region_t *p = perf_region(name);
+    if (p == NULL) return;
+    for (int c = 0; c < PERF_NCOUNTER; c++) {
+        p->start_counts[c] = perf_read(perf_fd[c]);
+    }
+    p->start_time = perf_now();
+}
+
+
+// `cells` is the number of grid points (or other work items) processed
+static inline
+void perf_region_end(const char *name, const double cells)
+{
+    const double end_time = perf_now();
+    uint64_t end_counts[PERF_NCOUNTER];
+    for (int c = 0; c < PERF_NCOUNTER; c++) {
+        end_counts[c] = perf_read(perf_fd[c]);
+    }
+
+    perf_region_t *p = perf_region(name);
+    if (p == NULL) return;
+    p->calls++;
+    p->cells += cells;
+    p->seconds += end_time - p->start_time;
+    for (int c = 0; c < PERF_NCOUNTER; c++) {
+        p->counts[c] += end_counts[c] - p->start_counts[c];
+    }
+}
+
+#else
+
+#define PERF_REGION_BEGIN(name)      ((void)0)
+#define PERF_REGION_END(name, cells) ((void)0)
+
+#endif
+
+#endif
@@ -0,0 +1,194 @@
+// SPDX-FileCopyrightText: 2026 CSC - IT Center for Science Ltd. <www.csc.fi>
+//
+// SPDX-License-Identifier: MIT
+
+// axpy with explicit SIMD vector types
+//
+// The vector width is chosen by the compiler for the target instruction set
+// (e.g. 4 doubles with AVX2, 8 doubles with AVX-512) through
+// std::experimental::native_simd. Compile e.g. with
+//
+//   g++ -std=c++17 -O3 -march=native axpy-simd.cpp -o axpy-simd
+//
+// and compare with -mavx2 or -mavx512f. The scalar template is compiled with
+// the same flags, so the compiler may vectorize it automatically; add
+// -fno-tree-vectorize to see the difference to a truly scalar loop.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <experimental/simd>
+#include <new>
+#include "bench.h"
+
+namespace stdx = std::experimental;
+
+template <typename T>
+void axpy(T *x, T *y, T a, size_t n)
+{
+  for (size_t i = 0; i < n; i++)
+  {
+    y[i] += a * x[i];
+  }
+}
+
+template <typename T>
+void axpy_simd(const T *x, T *y, T a, size_t n)
+{
+  using V = stdx::native_simd<T>;
+  constexpr size_t width = V::size();
+  constexpr size_t alignment = stdx::memory_alignment_v<V>;
+
+  // Scalar peel loop until y is aligned to the vector size
+  size_t i = 0;
+  while (i < n && reinterpret_cast<uintptr_t>(y + i) % alignment != 0)
+  {
+    y[i] += a * x[i];
+    i++;
+  }
+
+  // Main loop: y is aligned, x is aligned only if it has the same offset
+  const V av = a;
+  const bool x_aligned = reinterpret_cast<uintptr_t>(x + i) % alignment == 0;
+  if (x_aligned)
+  {
+    for (; i + width <= n; i += width)
+    {
+      V xv(x + i, stdx::vector_aligned);
+      V yv(y + i, stdx::vector_aligned);
+      yv += av * xv;
+      yv.copy_to(y + i, stdx::vector_aligned);
+    }
+  }
+  else
+  {
+    for (; i + width <= n; i += width)
+    {
+      V xv(x + i, stdx::element_aligned);
+      V yv(y + i, stdx::vector_aligned);
+      yv += av * xv;
+      yv.copy_to(y + i, stdx::vector_aligned);
+    }
+  }
+
+  // Remainder loop
+  for (; i < n; i++)
+  {
+    y[i] += a * x[i];
+  }
+}
+
+template <typename T>
+T *allocate(size_t n)
+{
+  // Aligned to a full cache line, which covers all the SIMD widths
+  return static_cast<T *>(::operator new[](n * sizeof(T), std::align_val_t(64)));
+}
+
+template <typename T>
+void deallocate(T *p)
+{
+  ::operator delete[](p, std::align_val_t(64));
+}
+
+// Median bandwidth of the given axpy implementation for n elements
+template <typename T, typename Axpy>
+double bandwidth(const char *type, const char *name, Axpy axpy_impl, T *x, T *y, T a, size_t n)
+{
+  // Repeat small arrays so that each sample takes roughly the same time
+  const size_t inner = std::max<size_t>(1, (size_t(1) << 24) / n);
+
+  char config[256];
+  snprintf(config, sizeof(config), "%s %s n=%zu", name, type, n);
+  bench_t bench;
+  bench_init(&bench, "axpy-simd", config, 2, 10);
+
+  for (int r = 0; r < bench_total_runs(&bench); r++)
+  {
+    double t0 = bench_time();
+    for (size_t k = 0; k < inner; k++)
+    {
+      axpy_impl(x, y, a, n);
+    }
+    bench_add(&bench, (bench_time() - t0) / inner);
+  }
+
+  // Two arrays read, one written
+  bench_stats_t stats = bench_report(&bench, 1.0e-9 * 3.0 * n * sizeof(T), "GB/s");
+  bench_free(&bench);
+  return stats.throughput;
+}
+
+// Compare to the scalar version with x and y offset from the aligned start
+template <typename T>
+bool check(size_t n, size_t x_offset, size_t y_offset)
+{
+  const size_t size = n + 16;
+  T *x = allocate<T>(size);
+  T *y = allocate<T>(size);
+  T *yref = allocate<T>(size);
+  for (size_t i = 0; i < size; i++)
+  {
+    x[i] = T(i % 17);
+    y[i] = T(i % 13);
+    yref[i] = y[i];
+  }
+
+  axpy(x + x_offset, yref + y_offset, T(3), n);
+  axpy_simd(x + x_offset, y + y_offset, T(3), n);
+
+  bool ok = std::equal(y, y + size, yref);
+  deallocate(x);
+  deallocate(y);
+  deallocate(yref);
+  return ok;
+}
+
+template <typename T>
+void run(const char *type, size_t max_bytes)
+{
+  using V = stdx::native_simd<T>;
+
+  // Aligned and misaligned arrays, with and without a remainder
+  const bool ok = check<T>(1024, 0, 0) && check<T>(1001, 1, 1)
+               && check<T>(1003, 0, 3) && check<T>(7, 2, 5);
+  printf("\n%s: %zu elements per vector, results %s\n",
+         type, V::size(), ok ? "agree" : "DIFFER");
+  printf("  %14s %16s %16s %8s\n", "size (KiB)", "scalar (GB/s)", "simd (GB/s)", "speedup");
+
+  // Sizes from within the L1 cache to main memory
+  for (size_t bytes = 4096; bytes <= max_bytes; bytes *= 4)
+  {
+    const size_t n = bytes / (2 * sizeof(T));
+    T *x = allocate<T>(n);
+    T *y = allocate<T>(n);
+    for (size_t i = 0; i < n; i++)
+    {
+      x[i] = T(1);
+      y[i] = T(0);
+    }
+
+    double scalar = bandwidth<T>(type, "scalar", axpy<T>, x, y, T(1), n);
+    double simd = bandwidth<T>(type, "simd", axpy_simd<T>, x, y, T(1), n);
+    printf("  %14zu %16.2f %16.2f %8.2f\n", bytes / 1024, scalar, simd, simd / scalar);
+
+    deallocate(x);
+    deallocate(y);
+  }
+}
+
+int main(int argc, char** argv)
+{
+  // Largest size of x and y together
+  size_t max_mib = 1024;
+  if (argc > 1)
+  {
+    max_mib = std::atoi(argv[1]);
+  }
+  const size_t max_bytes = max_mib * 1024 * 1024;
+
+  run<float>("float", max_bytes);
+  run<double>("double", max_bytes);
+  run<int>("int", max_bytes);
+}
@@ -0,0 +1,155 @@
+// SPDX-FileCopyrightText: 2026 CSC - IT Center for Science Ltd. <www.csc.fi>
+//
+// SPDX-License-Identifier: MIT
+
+// Memory traffic saved by fusing BLAS-1 operations
+//
+// Typical update sequences of iterative solvers (e.g. conjugate gradient)
+// are run in three ways:
+// - blas1:      one BLAS-1 call (copy, scal, axpy, dot) per pass over memory
+// - expression: each assignment evaluated as one fused expression
+// - fused:      assignment and dot product in a single loop (assign_dot)
+//
+// The traffic is counted in vector elements read or written per index,
+// assuming that the vectors do not fit in cache.
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include "bench.h"
+#include "fused_vector.hpp"
+
+using et::Vector;
+
+const char *backend()
+{
+#if defined(USE_KOKKOS)
+  return Kokkos::DefaultExecutionSpace::name();
+#elif defined(_OPENMP)
+  return "OpenMP";
+#else
+  return "serial";
+#endif
+}
+
+// Time the sequence and print one line of the table. reset() restores the
+// inputs of in-place updates outside the timed region, and check() returns
+// a value to compare with the expected result after the last repetition.
+template <class Reset, class Sequence, class Check>
+void run(const char *sequence, const char *variant, const int traffic, const int blas1_traffic,
+         const size_t n, const int nrep, const double expected,
+         const Reset &reset, const Sequence &f, const Check &check)
+{
+  char config[256];
+  snprintf(config, sizeof(config), "%s %s %s n=%zu", sequence, variant, backend(), n);
+  bench_t bench;
+  bench_init(&bench, "fused-blas1", config, 1, nrep);
+
+  for (int r = 0; r < bench_total_runs(&bench); r++) {
+    reset();
+    et::fence();
+    double t0 = bench_time();
+    f();
+    et::fence();
+    bench_add(&bench, bench_time() - t0);
+  }
+
+  const double bytes = 1.0 * traffic * n * sizeof(double);
+  bench_stats_t stats = bench_report(&bench, 1.0e-9 * bytes, "GB/s");
+  bench_free(&bench);
+
+  const double result = check();
+  const bool ok = std::fabs(result - expected) <= 1.0e-8 * std::fabs(expected);
+  printf("  %-12s %8d %10.1f%% %12.4f %10.2f %8s\n", variant, traffic,
+         100.0 * (blas1_traffic - traffic) / blas1_traffic,
+         1.0e3 * stats.median, stats.throughput, ok ? "ok" : "WRONG");
+}
+
+void header(const char *sequence)
+{
+  printf("\n%s\n", sequence);
+  printf("  %-12s %8s %11s %12s %10s %8s\n",
+         "variant", "traffic", "saved", "time (ms)", "GB/s", "result");
+}
+
+int main(int argc, char** argv)
+{
+#if defined(USE_KOKKOS)
+  Kokkos::initialize(argc, argv);
+  {
+#endif
+
+  size_t n = 1 << 25;
+  int nrep = 20;
+  if (argc > 1) n = std::atol(argv[1]);
+  if (argc > 2) nrep = std::atoi(argv[2]);
+
+  printf("Backend: %s, vector length %zu, %d repetitions\n", backend(), n, nrep);
+  printf("Traffic in vector elements moved per index\n");
+
+  Vector<double> x(n, "x"), y(n, "y"), z(n, "z"), w(n, "w");
+  Vector<double> r(n, "r"), q(n, "q"), p(n, "p");
+
+  const double a = 0.5, b = -0.25, alpha = 1.0e-3, beta = 0.5;
+
+  // Constant vectors so that the results are known exactly
+  x = 1.0;
+  y = 2.0;
+  w = 3.0;
+  q = 4.0;
+
+  double d = 0.0;
+  auto nothing = []() {};
+  auto result = [&]() { return d; };
+
+  // z = a*x + b*y; d = dot(z, w)
+  const char *s1 = "z = a*x + b*y; d = dot(z, w)";
+  const double d1 = n * (a * 1.0 + b * 2.0) * 3.0;
+  header(s1);
+  run(s1, "blas1", 9, 9, n, nrep, d1, nothing, [&]() {
+    et::copy(x, z);
+    et::scal(a, z);
+    et::axpy(b, y, z);
+    d = et::dot(z, w);
+  }, result);
+  run(s1, "expression", 5, 9, n, nrep, d1, nothing, [&]() {
+    z = a*x + b*y;
+    d = et::dot(z, w);
+  }, result);
+  run(s1, "fused", 4, 9, n, nrep, d1, nothing, [&]() {
+    d = et::assign_dot(z, a*x + b*y, w);
+  }, result);
+
+  // r = r - alpha*q; rr = dot(r, r), starting from r = 1
+  const char *s2 = "r = r - alpha*q; rr = dot(r, r)";
+  const double d2 = n * (1.0 - alpha * 4.0) * (1.0 - alpha * 4.0);
+  auto reset_r = [&]() { r = 1.0; };
+  header(s2);
+  run(s2, "blas1", 4, 4, n, nrep, d2, reset_r, [&]() {
+    et::axpy(-alpha, q, r);
+    d = et::dot(r, r);
+  }, result);
+  run(s2, "fused", 3, 4, n, nrep, d2, reset_r, [&]() {
+    d = et::assign_dot(r, r - alpha*q, r);
+  }, result);
+
+  // p = r + beta*p, starting from p = 2, r = 1
+  const char *s3 = "p = r + beta*p";
+  const double d3 = n * (1.0 + beta * 2.0);
+  auto reset_p = [&]() { r = 1.0; p = 2.0; };
+  auto sum_p = [&]() { return et::dot(p, r); };
+  header(s3);
+  run(s3, "blas1", 5, 5, n, nrep, d3, reset_p, [&]() {
+    et::scal(beta, p);
+    et::axpy(1.0, r, p);
+  }, sum_p);
+  run(s3, "expression", 3, 5, n, nrep, d3, reset_p, [&]() {
+    p = r + beta*p;
+  }, sum_p);
+
+#if defined(USE_KOKKOS)
+  }
+  Kokkos::finalize();
+#endif
+  return 0;
+}
@@ -0,0 +1,287 @@
+// SPDX-FileCopyrightText: 2026 CSC - IT Center for Science Ltd. <www.csc.fi>
+//
+// SPDX-License-Identifier: MIT
+
+// Vector type with expression templates for fused BLAS-1 operations
+//
+// Arithmetic on vectors does not compute anything, but builds a small
+// expression object describing the operation. The loop over the elements
+// is only run when the expression is assigned to a vector or reduced, so
+//
+//   z = a*x + b*y;
+//
+// reads x and y and writes z once, instead of one pass over memory per
+// operation. assign_dot(z, a*x + b*y, w) additionally computes dot(z, w)
+// in the same loop.
+//
+// The loops run on one of three backends, selected at compile time:
+// - Kokkos if USE_KOKKOS is defined (the vectors live in the default memory space)
+// - OpenMP threads if compiled with OpenMP
+// - a serial loop otherwise
+
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#if defined(USE_KOKKOS)
+#include <Kokkos_Core.hpp>
+#define ET_INLINE KOKKOS_INLINE_FUNCTION
+#else
+#include <vector>
+#define ET_INLINE inline
+#endif
+
+namespace et {
+
+// Backend loops
+
+template <class Functor>
+void parallel_for(const size_t n, const Functor &f)
+{
+#if defined(USE_KOKKOS)
+  Kokkos::parallel_for("et::for", Kokkos::RangePolicy<>(0, n), f);
+#else
+#if defined(_OPENMP)
+  #pragma omp parallel for
+#endif
+  for (size_t i = 0; i < n; i++) {
+    f(i);
+  }
+#endif
+}
+
+template <class T, class Functor>
+T parallel_sum(const size_t n, const Functor &f)
+{
+  T sum = 0;
+#if defined(USE_KOKKOS)
+  Kokkos::parallel_reduce("et::sum", Kokkos::RangePolicy<>(0, n), f, sum);
+#else
+#if defined(_OPENMP)
+  #pragma omp parallel for reduction(+:sum)
+#endif
+  for (size_t i = 0; i < n; i++) {
+    f(i, sum);
+  }
+#endif
+  return sum;
+}
+
+inline void fence()
+{
+#if defined(USE_KOKKOS)
+  Kokkos::fence();
+#endif
+}
+
+// Expression nodes
+//
+// The nodes are stored by value and contain only raw pointers and scalars,
+// so that they can be copied to the GPU by the Kokkos backend.
+
+struct ExprBase {};
+
+template <class T>
+struct Ref : ExprBase {
+  using value_type = T;
+  const T *p;
+  size_t n;
+  ET_INLINE T operator[](const size_t i) const { return p[i]; }
+  size_t size() const { return n; }
+};
+
+template <class Op, class L, class R>
+struct Binary : ExprBase {
+  using value_type = typename L::value_type;
+  L l;
+  R r;
+  ET_INLINE value_type operator[](const size_t i) const { return Op::apply(l[i], r[i]); }
+  size_t size() const { return l.size(); }
+};
+
+template <class E>
+struct Scale : ExprBase {
+  using value_type = typename E::value_type;
+  value_type s;
+  E e;
+  ET_INLINE value_type operator[](const size_t i) const { return s * e[i]; }
+  size_t size() const { return e.size(); }
+};
+
+struct Plus {
+  template <class T> ET_INLINE static T apply(const T a, const T b) { return a + b; }
+};
+struct Minus {
+  template <class T> ET_INLINE static T apply(const T a, const T b) { return a - b; }
+};
+struct Times {
+  template <class T> ET_INLINE static T apply(const T a, const T b) { return a * b; }
+};
+
+// Vector owning its data
+
+template <class T>
+class Vector {
+public:
+  using value_type = T;
+
+  explicit Vector(const size_t n, const char *label = "et::Vector")
+#if defined(USE_KOKKOS)
+    : data_(label, n) {}
+#else
+    : data_(n) { (void)label; }
+#endif
+
+  Vector(const Vector &) = delete;
+
+  size_t size() const { return data_.size(); }
+  T *data() { return data_.data(); }
+  const T *data() const { return data_.data(); }
+
+  // Evaluate an expression in a single loop
+  template <class E, class = std::enable_if_t<std::is_base_of_v<ExprBase, E>>>
+  Vector &operator=(const E &e)
+  {
+    T *z = data();
+    parallel_for(size(), Assign<E>{z, e});
+    return *this;
+  }
+
+  Vector &operator=(const Vector &other)
+  {
+    return *this = Ref<T>{{}, other.data(), other.size()};
+  }
+
+  Vector &operator=(const T value)
+  {
+    parallel_for(size(), Fill{data(), value});
+    return *this;
+  }
+
+private:
+  template <class E>
+  struct Assign {
+    T *z;
+    E e;
+    ET_INLINE void operator()(const size_t i) const { z[i] = e[i]; }
+  };
+
+  struct Fill {
+    T *z;
+    T value;
+    ET_INLINE void operator()(const size_t i) const { z[i] = value; }
+  };
+
+#if defined(USE_KOKKOS)
+  Kokkos::View<T*> data_;
+#else
+  std::vector<T> data_;
+#endif
+};
+
+// Vectors and expressions can be combined in any order
+
+template <class A>
+struct is_vector : std::false_type {};
+template <class T>
+struct is_vector<Vector<T>> : std::true_type {};
+
+template <class A>
+constexpr bool is_operand_v = std::is_base_of_v<ExprBase, A> || is_vector<A>::value;
+
+template <class T>
+Ref<T> leaf(const Vector<T> &v) { return {{}, v.data(), v.size()}; }
+
+template <class E, class = std::enable_if_t<std::is_base_of_v<ExprBase, E>>>
+const E &leaf(const E &e) { return e; }
+
+template <class A>
+using leaf_t = std::decay_t<decltype(leaf(std::declval<const A &>()))>;
+
+template <class A, class B, class = std::enable_if_t<is_operand_v<A> && is_operand_v<B>>>
+Binary<Plus, leaf_t<A>, leaf_t<B>> operator+(const A &a, const B &b)
+{
+  return {{}, leaf(a), leaf(b)};
+}
+
+template <class A, class B, class = std::enable_if_t<is_operand_v<A> && is_operand_v<B>>>
+Binary<Minus, leaf_t<A>, leaf_t<B>> operator-(const A &a, const B &b)
+{
+  return {{}, leaf(a), leaf(b)};
+}
+
+// Element-wise product
+template <class A, class B, class = std::enable_if_t<is_operand_v<A> && is_operand_v<B>>>
+Binary<Times, leaf_t<A>, leaf_t<B>> operator*(const A &a, const B &b)
+{
+  return {{}, leaf(a), leaf(b)};
+}
+
+template <class S, class A,
+          class = std::enable_if_t<std::is_arithmetic_v<S> && is_operand_v<A>>>
+Scale<leaf_t<A>> operator*(const S s, const A &a)
+{
+  return {{}, typename leaf_t<A>::value_type(s), leaf(a)};
+}
+
+template <class S, class A,
+          class = std::enable_if_t<std::is_arithmetic_v<S> && is_operand_v<A>>>
+Scale<leaf_t<A>> operator*(const A &a, const S s)
+{
+  return s * a;
+}
+
+// Reductions
+
+template <class X, class Y>
+struct DotFunctor {
+  X x;
+  Y y;
+  template <class T>
+  ET_INLINE void operator()(const size_t i, T &sum) const { sum += x[i] * y[i]; }
+};
+
+// dot(x, y) of any two expressions in a single loop
+template <class A, class B, class = std::enable_if_t<is_operand_v<A> && is_operand_v<B>>>
+typename leaf_t<A>::value_type dot(const A &a, const B &b)
+{
+  using T = typename leaf_t<A>::value_type;
+  return parallel_sum<T>(leaf(a).size(), DotFunctor<leaf_t<A>, leaf_t<B>>{leaf(a), leaf(b)});
+}
+
+template <class T, class E, class W>
+struct AssignDotFunctor {
+  T *z;
+  E e;
+  W w;
+  ET_INLINE void operator()(const size_t i, T &sum) const
+  {
+    const T value = e[i];
+    z[i] = value;
+    // Read w only after writing z, w may be z itself
+    sum += value * w[i];
+  }
+};
+
+// z = e followed by dot(z, w), fused into a single loop
+template <class T, class E, class B,
+          class = std::enable_if_t<std::is_base_of_v<ExprBase, E> && is_operand_v<B>>>
+T assign_dot(Vector<T> &z, const E &e, const B &w)
+{
+  return parallel_sum<T>(z.size(), AssignDotFunctor<T, E, leaf_t<B>>{z.data(), e, leaf(w)});
+}
+
+// Classic BLAS-1 routines, one pass over memory per call
+
+template <class T>
+void copy(const Vector<T> &x, Vector<T> &y) { y = x; }
+
+template <class T>
+void scal(const T a, Vector<T> &x) { x = a * x; }
+
+template <class T>
+void axpy(const T a, const Vector<T> &x, Vector<T> &y) { y = a * x + y; }
+
+} // namespace et
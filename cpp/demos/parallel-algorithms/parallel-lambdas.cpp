@@ -0,0 +1,137 @@
+// SPDX-FileCopyrightText: 2026 CSC - IT Center for Science Ltd. <www.csc.fi>
+//
+// SPDX-License-Identifier: MIT
+
+// The dot product and sorting lambdas of the lambda examples run serially,
+// with std::execution::par_unseq and with OpenMP on millions of elements
+//
+//   g++ -std=c++17 -O3 -fopenmp parallel-lambdas.cpp -o parallel-lambdas -ltbb
+//   ./parallel-lambdas [number of elements] [repetitions]
+//
+// The number of threads is set with OMP_NUM_THREADS for OpenMP and with the
+// CPU affinity mask (e.g. taskset) for TBB, see scaling.sh.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+#include <sched.h>
+#include "bench.h"
+#include "parallel.hpp"
+
+using par::Backend;
+
+struct Person {
+  std::string name;
+  int age;
+};
+
+// CPUs available to the process, the default number of TBB threads
+int available_cpus()
+{
+  cpu_set_t set;
+  if (sched_getaffinity(0, sizeof(set), &set) != 0) return 1;
+  return CPU_COUNT(&set);
+}
+
+template <class Setup, class Kernel>
+double run(const char *name, const Backend backend, const size_t n, const int nrep,
+           const Setup &setup, const Kernel &kernel)
+{
+  const int threads = par::threads(backend) ? par::threads(backend) : available_cpus();
+  char config[256];
+  snprintf(config, sizeof(config), "%s n=%zu threads=%d", par::name(backend), n, threads);
+  bench_t bench;
+  bench_init(&bench, name, config, 1, nrep);
+
+  for (int r = 0; r < bench_total_runs(&bench); r++) {
+    setup();
+    double t0 = bench_time();
+    kernel();
+    bench_add(&bench, bench_time() - t0);
+  }
+
+  bench_stats_t stats = bench_report(&bench, 1.0e-6 * n, "Melements/s");
+  bench_free(&bench);
+  return stats.median;
+}
+
+void header(const char *title)
+{
+  printf("\n%s\n", title);
+  printf("  %-10s %8s %12s %9s %8s\n", "backend", "threads", "time (ms)", "speedup", "result");
+}
+
+void row(const Backend backend, const double time, const double serial_time, const bool ok)
+{
+  const int threads = par::threads(backend) ? par::threads(backend) : available_cpus();
+  printf("  %-10s %8d %12.3f %9.2f %8s\n", par::name(backend), threads,
+         1.0e3 * time, serial_time / time, ok ? "ok" : "WRONG");
+}
+
+int main(int argc, char** argv)
+{
+  size_t n = 1 << 25;
+  int nrep = 10;
+  if (argc > 1) n = std::atol(argv[1]);
+  if (argc > 2) nrep = std::atoi(argv[2]);
+
+  const Backend backends[] = {Backend::serial, Backend::stdpar, Backend::openmp};
+
+  // Dot product
+  std::vector<double> xv(n), yv(n);
+  double *x = xv.data();
+  double *y = yv.data();
+
+  auto init = [=] (const size_t i) {
+    x[i] = cos(i * 2*M_PI / (n-1));
+    y[i] = sin(i * 2*M_PI / (n-1));
+  };
+  auto product = [=] (const size_t i) {
+    return x[i] * y[i];
+  };
+
+  header("Dot product (result should be 0)");
+  double serial_time = 0.0;
+  for (const Backend backend : backends) {
+    double result = 0.0;
+    // Initialize with the same backend, so that the pages are placed
+    // close to the threads using them
+    par::for_each(backend, n, init);
+    const double time = run("dot-product", backend, n, nrep, [](){}, [&]() {
+      result = par::transform_reduce(backend, n, 0.0, product);
+    });
+    if (backend == Backend::serial) serial_time = time;
+    row(backend, time, serial_time, std::fabs(result) < 1.0e-6);
+  }
+
+  // Sort by age
+  std::vector<Person> original(n);
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> age(0, 99);
+  for (size_t i = 0; i < n; i++) {
+    original[i] = {"Person " + std::to_string(i), age(gen)};
+  }
+
+  auto by_age = [](const Person &a, const Person &b) {
+    return a.age < b.age;
+  };
+
+  header("Sort people by age");
+  std::vector<Person> people;
+  for (const Backend backend : backends) {
+    // Restore the unsorted order before each repetition
+    const double time = run("sort", backend, n, nrep, [&]() {
+      people = original;
+    }, [&]() {
+      par::sort(backend, people.begin(), people.end(), by_age);
+    });
+    if (backend == Backend::serial) serial_time = time;
+    row(backend, time, serial_time, std::is_sorted(people.begin(), people.end(), by_age));
+  }
+
+  return 0;
+}
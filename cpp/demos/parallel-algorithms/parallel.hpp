@@ -0,0 +1,172 @@
+// SPDX-FileCopyrightText: 2026 CSC - IT Center for Science Ltd. <www.csc.fi>
+//
+// SPDX-License-Identifier: MIT
+
+// Run the same lambdas serially, with the C++17 parallel algorithms
+// (std::execution::par_unseq) or with OpenMP threads
+//
+//   par::for_each(backend, n, [=](size_t i) { ... });
+//   double sum = par::transform_reduce(backend, n, 0.0, [=](size_t i) { return ...; });
+//   par::sort(backend, v.begin(), v.end(), [](const T &a, const T &b) { ... });
+//
+// With GCC the parallel algorithms need TBB (link with -ltbb), with NVHPC
+// compile with -stdpar=multicore (or -stdpar=gpu for the GPU).
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <execution>
+#include <iterator>
+#include <numeric>
+#include <vector>
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+namespace par {
+
+enum class Backend { serial, stdpar, openmp };
+
+inline const char *name(const Backend backend)
+{
+  switch (backend) {
+    case Backend::serial: return "serial";
+    case Backend::stdpar: return "par_unseq";
+    case Backend::openmp: return "openmp";
+  }
+  return "";
+}
+
+inline int threads(const Backend backend)
+{
+#if defined(_OPENMP)
+  if (backend == Backend::openmp) return omp_get_max_threads();
+#endif
+  return backend == Backend::serial ? 1 : 0;  // 0 = decided by the library
+}
+
+// Random access iterator over the indices 0, 1, 2, ... so that the
+// standard algorithms can call the same index-based lambdas
+class counting_iterator {
+public:
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = size_t;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const size_t *;
+  using reference = size_t;
+
+  counting_iterator() = default;
+  explicit counting_iterator(const size_t i) : i_(i) {}
+
+  size_t operator*() const { return i_; }
+  size_t operator[](const difference_type n) const { return i_ + n; }
+
+  counting_iterator &operator++() { ++i_; return *this; }
+  counting_iterator operator++(int) { auto old = *this; ++i_; return old; }
+  counting_iterator &operator--() { --i_; return *this; }
+  counting_iterator operator--(int) { auto old = *this; --i_; return old; }
+  counting_iterator &operator+=(const difference_type n) { i_ += n; return *this; }
+  counting_iterator &operator-=(const difference_type n) { i_ -= n; return *this; }
+
+  friend counting_iterator operator+(counting_iterator it, const difference_type n) { return it += n; }
+  friend counting_iterator operator+(const difference_type n, counting_iterator it) { return it += n; }
+  friend counting_iterator operator-(counting_iterator it, const difference_type n) { return it -= n; }
+  friend difference_type operator-(const counting_iterator a, const counting_iterator b)
+  {
+    return static_cast<difference_type>(a.i_) - static_cast<difference_type>(b.i_);
+  }
+
+  friend bool operator==(const counting_iterator a, const counting_iterator b) { return a.i_ == b.i_; }
+  friend bool operator!=(const counting_iterator a, const counting_iterator b) { return a.i_ != b.i_; }
+  friend bool operator<(const counting_iterator a, const counting_iterator b) { return a.i_ < b.i_; }
+  friend bool operator>(const counting_iterator a, const counting_iterator b) { return a.i_ > b.i_; }
+  friend bool operator<=(const counting_iterator a, const counting_iterator b) { return a.i_ <= b.i_; }
+  friend bool operator>=(const counting_iterator a, const counting_iterator b) { return a.i_ >= b.i_; }
+
+private:
+  size_t i_ = 0;
+};
+
+template <class F>
+void for_each(const Backend backend, const size_t n, const F &f)
+{
+  switch (backend) {
+    case Backend::serial:
+      for (size_t i = 0; i < n; i++) f(i);
+      break;
+    case Backend::stdpar:
+      std::for_each(std::execution::par_unseq, counting_iterator(0), counting_iterator(n), f);
+      break;
+    case Backend::openmp:
+      #pragma omp parallel for
+      for (size_t i = 0; i < n; i++) f(i);
+      break;
+  }
+}
+
+// Sum of f(i) over i = 0, ..., n-1
+template <class T, class F>
+T transform_reduce(const Backend backend, const size_t n, const T init, const F &f)
+{
+  T sum = init;
+  switch (backend) {
+    case Backend::serial:
+      for (size_t i = 0; i < n; i++) sum += f(i);
+      break;
+    case Backend::stdpar:
+      sum = std::transform_reduce(std::execution::par_unseq, counting_iterator(0),
+                                  counting_iterator(n), init, std::plus<T>(), f);
+      break;
+    case Backend::openmp:
+      #pragma omp parallel for reduction(+:sum)
+      for (size_t i = 0; i < n; i++) sum += f(i);
+      break;
+  }
+  return sum;
+}
+
+// OpenMP sort: each thread sorts one chunk, then the sorted chunks are
+// merged pairwise in parallel until one chunk remains
+template <class Iterator, class Compare>
+void openmp_sort(const Iterator first, const Iterator last, const Compare &comp)
+{
+  const size_t n = std::distance(first, last);
+  int nchunk = 1;
+#if defined(_OPENMP)
+  nchunk = omp_get_max_threads();
+#endif
+  std::vector<size_t> bounds(nchunk + 1);
+  for (int c = 0; c <= nchunk; c++) bounds[c] = n * c / nchunk;
+
+  #pragma omp parallel for schedule(static, 1)
+  for (int c = 0; c < nchunk; c++) {
+    std::sort(first + bounds[c], first + bounds[c + 1], comp);
+  }
+
+  for (int width = 1; width < nchunk; width *= 2) {
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int c = 0; c < nchunk - width; c += 2 * width) {
+      const int end = std::min(c + 2 * width, nchunk);
+      std::inplace_merge(first + bounds[c], first + bounds[c + width], first + bounds[end], comp);
+    }
+  }
+}
+
+template <class Iterator, class Compare>
+void sort(const Backend backend, const Iterator first, const Iterator last, const Compare &comp)
+{
+  switch (backend) {
+    case Backend::serial:
+      std::sort(first, last, comp);
+      break;
+    case Backend::stdpar:
+      std::sort(std::execution::par_unseq, first, last, comp);
+      break;
+    case Backend::openmp:
+      openmp_sort(first, last, comp);
+      break;
+  }
+}
+
+} // namespace par
@@ -0,0 +1,33 @@
+#!/bin/bash
+
+# SPDX-FileCopyrightText: 2026 CSC - IT Center for Science Ltd. <www.csc.fi>
+#
+# SPDX-License-Identifier: MIT
+
+# Thread scaling of parallel-lambdas on one node, e.g.
+#
+#   sbatch --account=... --partition=... --cpus-per-task=128 scaling.sh
+#
+# The results of all runs are collected in scaling.csv
+
+#SBATCH --job-name=parallel-lambdas
+#SBATCH --nodes=1
+#SBATCH --ntasks-per-node=1
+#SBATCH --time=00:30:00
+
+set -euo pipefail
+
+ncpu=${SLURM_CPUS_PER_TASK:-$(nproc)}
+n=${1:-100000000}
+
+export BENCH_OUTPUT=scaling.csv
+export OMP_PROC_BIND=close
+export OMP_PLACES=cores
+
+t=1
+while [ $t -le $ncpu ]; do
+    echo "=== $t threads ==="
+    # OpenMP uses OMP_NUM_THREADS, TBB all CPUs in the affinity mask
+    OMP_NUM_THREADS=$t taskset -c 0-$((t-1)) ./parallel-lambdas $n
+    t=$((t*2))
+done
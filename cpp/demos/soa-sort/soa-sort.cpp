@@ -0,0 +1,130 @@
+// SPDX-FileCopyrightText: 2026 CSC - IT Center for Science Ltd. <www.csc.fi>
+//
+// SPDX-License-Identifier: MIT
+
+// Sorting people by age: array of structures vs. structure of arrays
+//
+//   g++ -std=c++17 -O3 -fopenmp soa-sort.cpp -o soa-sort -ltbb
+//   ./soa-sort [largest number of records] [repetitions]
+//
+// The sizes go from 10^6 up to the given number of records (default 10^8,
+// which needs about 10 GB of memory).
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <execution>
+#include <random>
+#include <string>
+#include <vector>
+#include "bench.h"
+#include "soa.hpp"
+
+struct Person {
+  std::string name;
+  int age;
+};
+
+using People = soa::Records<std::string, int>;
+
+enum { NAME, AGE };
+
+template <class Setup, class Kernel>
+double run(const char *variant, const size_t n, const int nrep,
+           const Setup &setup, const Kernel &kernel)
+{
+  char config[256];
+  snprintf(config, sizeof(config), "%s n=%zu", variant, n);
+  bench_t bench;
+  bench_init(&bench, "soa-sort", config, 1, nrep);
+
+  for (int r = 0; r < bench_total_runs(&bench); r++) {
+    setup();
+    double t0 = bench_time();
+    kernel();
+    bench_add(&bench, bench_time() - t0);
+  }
+
+  bench_stats_t stats = bench_report(&bench, 1.0e-6 * n, "Mrecords/s");
+  bench_free(&bench);
+  return stats.median;
+}
+
+// Sorted by age, and people of the same age in their original order
+bool check(const People &people, const std::vector<int> &original_age)
+{
+  const auto &name = people.column<NAME>();
+  const auto &age = people.column<AGE>();
+  long previous = -1;
+  for (size_t i = 0; i < people.size(); i++) {
+    const long index = std::atol(name[i].c_str() + 7);  // "Person <index>"
+    if (age[i] != original_age[index]) return false;
+    if (i > 0 && (age[i] < age[i-1] || (age[i] == age[i-1] && index < previous))) return false;
+    previous = index;
+  }
+  return true;
+}
+
+int main(int argc, char** argv)
+{
+  size_t max_n = 100000000;
+  int nrep = 5;
+  if (argc > 1) max_n = std::atol(argv[1]);
+  if (argc > 2) nrep = std::atoi(argv[2]);
+
+  auto by_age = [](const Person &a, const Person &b) {
+    return a.age < b.age;
+  };
+
+  printf("  %12s %14s %14s %14s %14s %14s %9s %8s\n", "records", "aos (ms)",
+         "aos par (ms)", "soa (ms)", "key sort (ms)", "permute (ms)", "speedup", "result");
+
+  for (size_t n = 1000000; n <= max_n; n *= 10) {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> random_age(0, 99);
+    std::vector<int> original_age(n);
+    for (size_t i = 0; i < n; i++) original_age[i] = random_age(gen);
+
+    // Array of structures, sorted by moving the structures
+    std::vector<Person> original(n), aos;
+    for (size_t i = 0; i < n; i++) {
+      original[i] = {"Person " + std::to_string(i), original_age[i]};
+    }
+    const double t_aos = run("aos std::sort", n, nrep, [&]() { aos = original; }, [&]() {
+      std::sort(aos.begin(), aos.end(), by_age);
+    });
+    const double t_aos_par = run("aos std::sort par_unseq", n, nrep, [&]() { aos = original; }, [&]() {
+      std::sort(std::execution::par_unseq, aos.begin(), aos.end(), by_age);
+    });
+    aos.clear();
+    aos.shrink_to_fit();
+
+    // Structure of arrays, sorted by the keys and permuted once
+    People source(n), people;
+    for (size_t i = 0; i < n; i++) {
+      source.column<NAME>()[i] = std::move(original[i].name);
+      source.column<AGE>()[i] = original[i].age;
+    }
+    original.clear();
+    original.shrink_to_fit();
+    std::vector<uint32_t> perm;
+    auto reset = [&]() { people = source; };
+
+    const double t_key = run("soa key sort", n, nrep, reset, [&]() {
+      perm = soa::sort_by_key(people.column<AGE>());
+    });
+    const double t_permute = run("soa permute", n, nrep, reset, [&]() {
+      people.permute(perm);
+    });
+    const double t_soa = run("soa sort", n, nrep, reset, [&]() {
+      people.permute(soa::sort_by_key(people.column<AGE>()));
+    });
+    const bool ok = check(people, original_age);
+
+    printf("  %12zu %14.2f %14.2f %14.2f %14.2f %14.2f %9.2f %8s\n", n,
+           1.0e3 * t_aos, 1.0e3 * t_aos_par, 1.0e3 * t_soa, 1.0e3 * t_key,
+           1.0e3 * t_permute, t_aos / t_soa, ok ? "ok" : "WRONG");
+  }
+
+  return 0;
+}
@@ -0,0 +1,165 @@
+// SPDX-FileCopyrightText: 2026 CSC - IT Center for Science Ltd. <www.csc.fi>
+//
+// SPDX-License-Identifier: MIT
+
+// Structure-of-arrays record container with a parallel key sort
+//
+// Instead of std::vector<Person> with Person = {name, age}, the fields are
+// stored as separate columns:
+//
+//   soa::Records<std::string, int> people(n);
+//   people.column<0>()[i] = "Jussi";
+//   people.column<1>()[i] = 30;
+//
+// sort_by_key(people.column<1>()) only touches the integer keys: a parallel
+// LSD radix sort computes the sorted order as a permutation of indices,
+// and people.permute() then moves every column into that order once.
+// Sorting the structures directly would move the names in every step.
+
+#pragma once
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+namespace soa {
+
+template <class... Ts>
+class Records {
+public:
+  Records() = default;
+  explicit Records(const size_t n) : columns_(std::vector<Ts>(n)...) {}
+
+  size_t size() const { return std::get<0>(columns_).size(); }
+
+  template <size_t I> auto &column() { return std::get<I>(columns_); }
+  template <size_t I> const auto &column() const { return std::get<I>(columns_); }
+
+  // Reorder all columns so that new record i is old record perm[i]
+  void permute(const std::vector<uint32_t> &perm)
+  {
+    std::apply([&](auto &... columns) { (permute_column(columns, perm), ...); }, columns_);
+  }
+
+private:
+  template <class T>
+  static void permute_column(std::vector<T> &column, const std::vector<uint32_t> &perm)
+  {
+    const size_t n = column.size();
+    std::vector<T> sorted(n);
+    #pragma omp parallel for
+    for (size_t i = 0; i < n; i++) {
+      sorted[i] = std::move(column[perm[i]]);
+    }
+    column.swap(sorted);
+  }
+
+  std::tuple<std::vector<Ts>...> columns_;
+};
+
+// Map the keys to unsigned integers with the same order
+template <class Key>
+inline auto radix_key(const Key key)
+{
+  static_assert(std::is_integral_v<Key>, "radix sort needs integer keys");
+  using U = std::make_unsigned_t<Key>;
+  if constexpr (std::is_signed_v<Key>) {
+    // Flip the sign bit so that negative keys come first
+    return static_cast<U>(static_cast<U>(key) ^ (U(1) << (sizeof(Key) * CHAR_BIT - 1)));
+  } else {
+    return key;
+  }
+}
+
+// Stable sort of the keys, returned as the permutation of indices that
+// puts them in ascending order. Each pass sorts by one byte of the key:
+// every thread counts the bytes of its own contiguous block, an exclusive
+// scan over (byte, thread) gives each thread its output positions, and the
+// threads then scatter their blocks independently. Passes over bytes that
+// are the same for all keys are skipped, so small key ranges (e.g. ages)
+// need only one pass.
+template <class Key>
+std::vector<uint32_t> sort_by_key(const std::vector<Key> &keys)
+{
+  using U = decltype(radix_key(Key()));
+  constexpr int radix = 256;
+  constexpr int npass = sizeof(U);
+  const size_t n = keys.size();
+
+  std::vector<U> key(n), key_tmp(n);
+  std::vector<uint32_t> perm(n), perm_tmp(n);
+
+  // Bits that differ between any keys decide which passes are needed
+  U all_or = 0, all_and = U(~U(0));
+  #pragma omp parallel for reduction(|:all_or) reduction(&:all_and)
+  for (size_t i = 0; i < n; i++) {
+    key[i] = radix_key(keys[i]);
+    perm[i] = i;
+    all_or |= key[i];
+    all_and &= key[i];
+  }
+  const U varying = all_or ^ all_and;
+
+  int nthreads = 1;
+#if defined(_OPENMP)
+  nthreads = omp_get_max_threads();
+#endif
+  std::vector<size_t> count(nthreads * radix);
+
+  for (int pass = 0; pass < npass; pass++) {
+    const int shift = 8 * pass;
+    if (((varying >> shift) & 0xff) == 0) continue;
+
+    #pragma omp parallel num_threads(nthreads)
+    {
+      int t = 0, nt = 1;
+#if defined(_OPENMP)
+      t = omp_get_thread_num();
+      nt = omp_get_num_threads();
+#endif
+      const size_t begin = n * t / nt;
+      const size_t end = n * (t + 1) / nt;
+      size_t *offset = &count[t * radix];
+
+      for (int d = 0; d < radix; d++) offset[d] = 0;
+      for (size_t i = begin; i < end; i++) {
+        offset[(key[i] >> shift) & 0xff]++;
+      }
+
+      #pragma omp barrier
+      #pragma omp single
+      {
+        // Output position of (byte d, thread t): all smaller bytes, then
+        // the same byte in the blocks of the earlier threads
+        size_t sum = 0;
+        for (int d = 0; d < radix; d++) {
+          for (int s = 0; s < nt; s++) {
+            const size_t c = count[s * radix + d];
+            count[s * radix + d] = sum;
+            sum += c;
+          }
+        }
+      }
+
+      for (size_t i = begin; i < end; i++) {
+        const size_t j = offset[(key[i] >> shift) & 0xff]++;
+        key_tmp[j] = key[i];
+        perm_tmp[j] = perm[i];
+      }
+    }
+
+    key.swap(key_tmp);
+    perm.swap(perm_tmp);
+  }
+
+  return perm;
+}
+
+} // namespace soa
@@ -0,0 +1 @@
+../../compensated_sum.hpp
\ No newline at end of file
@@ -0,0 +1,129 @@
+// SPDX-FileCopyrightText: 2026 CSC - IT Center for Science Ltd. <www.csc.fi>
+//
+// SPDX-License-Identifier: MIT
+
+// Accuracy and cost of compensated and reproducible dot products compared
+// to the plain parallel_reduce
+
+#include <Kokkos_Core.hpp>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "bench.h"
+#include "compensated_sum.hpp"
+#include "reproducible_sum.hpp"
+
+template <class Dot>
+double run(const char *mode, const int64_t n, const double reference, const double reversed,
+           const Dot &dot, const double plain_time)
+{
+  char config[256];
+  snprintf(config, sizeof(config), "%s %s n=%lld", mode,
+           Kokkos::DefaultExecutionSpace::name(), (long long)n);
+  bench_t bench;
+  bench_init(&bench, "kokkos-dot-product", config, 1, 20);
+
+  double result = 0.0;
+  for (int r = 0; r < bench_total_runs(&bench); r++) {
+    double t0 = bench_time();
+    result = dot();
+    Kokkos::fence();
+    bench_add(&bench, bench_time() - t0);
+  }
+
+  // Two arrays read
+  bench_stats_t stats = bench_report(&bench, 1.0e-9 * 2 * n * sizeof(double), "GB/s");
+  bench_free(&bench);
+
+  const double time = plain_time > 0.0 ? plain_time : stats.median;
+  printf("  %-13s %24.17e %10.2e %10s %10.2f %9.2f\n", mode, result, std::fabs(result - reference),
+         std::memcmp(&result, &reversed, sizeof(double)) == 0 ? "yes" : "no",
+         stats.throughput, stats.median / time);
+  return stats.median;
+}
+
+int main(int argc, char** argv)
+{
+  Kokkos::initialize(argc, argv);
+  {
+
+  int64_t n = 100000000;
+  if (argc > 1) n = std::atol(argv[1]);
+  printf("Backend: %s, vector length %lld\n", Kokkos::DefaultExecutionSpace::name(), (long long)n);
+
+  Kokkos::View<double*> x("x", n), y("y", n);
+  Kokkos::parallel_for(n, KOKKOS_LAMBDA (const int64_t i) {
+    x(i) = cos(i * 2*M_PI / (n-1));
+    y(i) = sin(i * 2*M_PI / (n-1));
+  });
+  Kokkos::fence();
+
+  // Serial sums on the host in reverse order, i.e. with a different rounding
+  auto xh = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), x);
+  auto yh = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(), y);
+  double plain_reversed = 0.0, max_abs = 0.0;
+  compensated::Value compensated_sum;
+  for (int64_t i = n - 1; i >= 0; i--) {
+    plain_reversed += xh(i) * yh(i);
+    compensated_sum.add(xh(i) * yh(i));
+    max_abs = std::fmax(max_abs, std::fabs(xh(i) * yh(i)));
+  }
+  const double compensated_reversed = compensated_sum.result();
+  const auto bins = reproducible::make_bins(max_abs, n);
+  reproducible::Value sum;
+  for (int64_t i = n - 1; i >= 0; i--) {
+    sum.add(bins, xh(i) * yh(i));
+  }
+  const double reproducible_reversed = sum.result();
+
+  // Accurate reference: each product is split exactly into the rounded
+  // product p and its rounding error e = x * y - p, computed with a fused
+  // multiply-add (TwoProduct), and all p and e are added with a compensated
+  // sum in extended precision. The reference is thus the dot product of the
+  // exact products, while the modes below add the rounded products, so
+  // their errors include the rounding of the products.
+  long double reference_sum = 0.0, reference_c = 0.0;
+  auto add = [&](const long double term) {
+    const long double t = reference_sum + term;
+    if (std::fabs(reference_sum) >= std::fabs(term)) {
+      reference_c += (reference_sum - t) + term;
+    } else {
+      reference_c += (term - t) + reference_sum;
+    }
+    reference_sum = t;
+  };
+  for (int64_t i = 0; i < n; i++) {
+    const double p = xh(i) * yh(i);
+    add(p);
+    add(std::fma(xh(i), yh(i), -p));
+  }
+  const double reference = reference_sum + reference_c;
+
+  printf("Dot product (should be 0), reference %.17e\n", reference);
+  printf("  %-13s %24s %10s %10s %10s %9s\n", "mode", "result",
+         "error", "=reversed", "GB/s", "time");
+
+  const double plain_time = run("plain", n, reference, plain_reversed, [&]() {
+    double result = 0.0;
+    Kokkos::parallel_reduce("dot", n, KOKKOS_LAMBDA (const int64_t i, double &local_result) {
+      local_result += x(i) * y(i);
+    }, result);
+    return result;
+  }, 0.0);
+
+  run("compensated", n, reference, compensated_reversed, [&]() {
+    return compensated::parallel_sum("dot", n, KOKKOS_LAMBDA (const int64_t i) {
+      return x(i) * y(i);
+    });
+  }, plain_time);
+
+  run("reproducible", n, reference, reproducible_reversed, [&]() {
+    return reproducible::parallel_sum("dot", n, KOKKOS_LAMBDA (const int64_t i) {
+      return x(i) * y(i);
+    });
+  }, plain_time);
+
+  }
+  Kokkos::finalize();
+}
@@ -0,0 +1 @@
+../../reproducible_sum.hpp
\ No newline at end of file
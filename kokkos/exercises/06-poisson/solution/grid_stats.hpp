@@ -0,0 +1 @@
+../../grid_stats.hpp
\ No newline at end of file
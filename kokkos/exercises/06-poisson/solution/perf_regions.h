@@ -0,0 +1 @@
+../../../../common/perf_regions.h
\ No newline at end of file
@@ -6,6 +6,10 @@
 #include <iostream>
 #include <cstdio>
 #include <cmath>
+#include "mdrange_autotune.hpp"
+#include "grid_stats.hpp"
+#include "bench.h"
+#include "perf_regions.h"
 
 // Initialize 2d array with Gaussian
 template <typename T>
@@ -19,8 +23,7 @@ void init(T x)
   double kx = 20.0 / nx;  // Spatial frequency in x
   double ky = 10.0 / ny;  // Spatial frequency in y
 
-  Kokkos::parallel_for("init",
-    Kokkos::MDRangePolicy<Kokkos::Rank<2> >({0, 0}, {nx, ny}),
+  mdrange_autotune::parallel_for("init", {0, 0}, {nx, ny},
       KOKKOS_LAMBDA(const int i, const int j) {
         double dx = j - cx;
         double dy = i - cy;
@@ -29,7 +32,25 @@ void init(T x)
       });
 }
 
-void run(const int n, const int niter)
+// Jacobi update of unew from u
+template <typename T>
+auto jacobi(T u, T unew, T f, const double h2)
+{
+  return KOKKOS_LAMBDA(const int i, const int j) {
+    unew(i, j) = 0.25 * (u(i-1, j) + u(i+1, j) + u(i, j-1) + u(i, j+1) - h2 * f(i, j));
+  };
+}
+
+// Statistics of u per quadrant
+template <typename T>
+auto quadrant_stats(T u, const int nx, const int ny)
+{
+  return KOKKOS_LAMBDA(const int i, const int j, grid_stats::Value& s) {
+    s.add(grid_stats::quadrant(i, j, nx, ny), u(i,j));
+  };
+}
+
+double run(const int n, const int niter)
 {
 
   const int nx = n, ny = n;
@@ -42,19 +63,24 @@ void run(const int n, const int niter)
   Kokkos::deep_copy(unew, 0.0);
   init(f);
 
+  // Select the tiles before the timer starts, so that the timings do not
+  // include the tuning launches
+  grid_stats::Value stats;
+  mdrange_autotune::tune("jacobi", {1, 1}, {nx-1, ny-1}, jacobi(u, unew, f, h2));
+  mdrange_autotune::tune("reduce", {1, 1}, {nx-1, ny-1}, quadrant_stats(u, nx, ny),
+                         grid_stats::QuadrantStats<Kokkos::HostSpace>(stats));
+
   Kokkos::Timer timer;
   double t0 = timer.seconds();
 
   // Jacobi iteration
   #pragma nounroll
   for (int iter = 0; iter < niter; iter++) {
-    Kokkos::parallel_for("jacobi",
-      Kokkos::MDRangePolicy<Kokkos::Rank<2> >({1, 1}, {nx-1, ny-1}),
-        KOKKOS_LAMBDA(const int i, const int j) {
-          unew(i, j) = 0.25 * (u(i-1, j) + u(i+1, j) + u(i, j-1) + u(i, j+1) - h2 * f(i, j));
-        });
+    PERF_REGION_BEGIN("jacobi");
+    mdrange_autotune::parallel_for("jacobi", {1, 1}, {nx-1, ny-1}, jacobi(u, unew, f, h2));
 
     Kokkos::fence();
+    PERF_REGION_END("jacobi", (nx - 2.0) * (ny - 2.0));
 
     std::swap(u, unew);
   }
@@ -69,15 +95,13 @@ void run(const int n, const int niter)
   size_t written = fwrite(u_host.data(), sizeof(double), count, file);
   fclose(file);
 
-  // Check the result
-  double mean = 0.0;
-  Kokkos::parallel_reduce("reduce",
-    Kokkos::MDRangePolicy<Kokkos::Rank<2> >({1, 1}, {nx-1, ny-1}),
-        KOKKOS_LAMBDA(const int i, const int j, double& mean) {
-           mean += u(i,j);
-        }, mean);
+  // Check the result: statistics of the interior per quadrant in a single pass
+  mdrange_autotune::parallel_reduce("reduce", {1, 1}, {nx-1, ny-1}, quadrant_stats(u, nx, ny),
+                                    grid_stats::QuadrantStats<Kokkos::HostSpace>(stats));
 
-  mean /= ((nx - 1) * (ny - 1));
+  const grid_stats::Stat all = stats.total();
+  // Same normalisation as the serial version, so that the printed mean matches
+  double mean = all.sum / ((nx - 1.0) * (ny - 1.0));
 
   double t1 = timer.seconds();
   double elapsed_seconds = t1 - t0;
@@ -85,12 +109,14 @@ void run(const int n, const int niter)
   int i = ny / 2, j = nx / 2;
   printf("u[%d,%d] = %f\n", i, j, u_host(i, j));
   printf("Mean u = %f\n", mean);
+  grid_stats::print(stats, h2);
   printf("Time spent: %6.3f s\n", elapsed_seconds);
   // Two arrays read, one written
   double total_bytes = 3.0 * count * sizeof(double);
   double bandwidth = niter * total_bytes / elapsed_seconds * 1.0e-9;
   printf("Performance: %5f GB/s\n", bandwidth);
 
+  return elapsed_seconds;
 }
 
 int main(int argc, char *argv[])
@@ -102,6 +128,16 @@ int main(int argc, char *argv[])
   // Number of iterations
   int niter = 500;
 
+  // Number of repetitions
+  int nrep = 1;
+
+  if (argc > 3) {
+      nrep = std::atoi(argv[3]);
+      if (nrep < 1) {
+          printf("Number of repetitions need to be greater than zero.\n");
+          return 1;
+      }
+  }
   if (argc > 2) {
       niter = std::atoi(argv[2]);
       if (niter < 1) {
@@ -117,7 +153,22 @@ int main(int argc, char *argv[])
       }
   }
 
-  run(n, niter);
+  char config[256];
+  snprintf(config, sizeof(config), "n=%d niter=%d space=%s", n, niter,
+           Kokkos::DefaultExecutionSpace::name());
+  bench_t bench;
+  bench_init(&bench, "poisson", config, 0, nrep);
+
+  for (int r = 0; r < bench_total_runs(&bench); r++) {
+    bench_add(&bench, run(n, niter));
+  }
+
+  mdrange_autotune::report();
+
+  // Two arrays read, one written per iteration
+  bench_stats_t stats = bench_report(&bench, 1.0e-9 * niter * 3.0 * n * n * sizeof(double), "GB/s");
+  bench_print(&bench, &stats);
+  bench_free(&bench);
 
   Kokkos::finalize();
   return 0;
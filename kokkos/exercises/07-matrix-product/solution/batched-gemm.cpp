@@ -0,0 +1,134 @@
+// SPDX-FileCopyrightText: 2026 CSC - IT Center for Science Ltd. <www.csc.fi>
+//
+// SPDX-License-Identifier: MIT
+
+#include <Kokkos_Core.hpp>
+#include <Kokkos_Random.hpp>
+#include <cstdio>
+#include "batched_gemm.hpp"
+#include "bench.h"
+
+using View3 = Kokkos::View<double***>;
+
+// Median time of a single call over the iterations, after one warm-up call
+template <class Gemm>
+double time_gemm(const char *config, const double nflops, const Gemm &gemm, const int iterations) {
+
+    bench_t bench;
+    bench_init(&bench, "batched-gemm", config, 1, iterations);
+
+    for (int iter = 0; iter < bench_total_runs(&bench); iter++) {
+      double t0 = bench_time();
+      gemm();
+      Kokkos::fence();
+      bench_add(&bench, bench_time() - t0);
+    }
+
+    bench_stats_t stats = bench_report(&bench, 1.0e-9 * nflops, "GFLOP/s");
+    bench_free(&bench);
+
+    return stats.median;
+}
+
+// Largest difference between two batches relative to the largest element
+double max_relative_difference(const View3 &X, const View3 &Y) {
+
+    double diff = 0.0, scale = 0.0;
+    Kokkos::parallel_reduce("max_difference", X.size(),
+      KOKKOS_LAMBDA(const size_t i, double &d) {
+        double x = Kokkos::abs(X.data()[i] - Y.data()[i]);
+        if (x > d) d = x;
+      }, Kokkos::Max<double>(diff));
+    Kokkos::parallel_reduce("max_value", Y.size(),
+      KOKKOS_LAMBDA(const size_t i, double &s) {
+        double x = Kokkos::abs(Y.data()[i]);
+        if (x > s) s = x;
+      }, Kokkos::Max<double>(scale));
+
+    return scale > 0.0 ? diff / scale : diff;
+}
+
+void batched_gemm(const int batch, const int n, const int iterations) {
+
+    View3 A("A", batch, n, n);
+    View3 B("B", batch, n, n);
+    View3 C("C", batch, n, n);
+    View3 C_team("C_team", batch, n, n);
+    View3 C_vector("C_vector", batch, n, n);
+
+    const double alpha = 1.234567;
+    const double beta = 0.89987234;
+
+    Kokkos::Random_XorShift64_Pool<> random_pool(12345);
+    Kokkos::fill_random(A, random_pool, -1.0, 1.0);
+    Kokkos::fill_random(B, random_pool, -1.0, 1.0);
+    Kokkos::fill_random(C, random_pool, -1.0, 1.0);
+
+    // Both strategies should give the same result
+    Kokkos::deep_copy(C_team, C);
+    Kokkos::deep_copy(C_vector, C);
+    batched_gemm_team(alpha, A, B, beta, C_team);
+    batched_gemm_vector(alpha, A, B, beta, C_vector);
+    double diff = max_relative_difference(C_vector, C_team);
+
+    double nflops = 2.0 * batch * n * n * n;
+    char config[256];
+
+    snprintf(config, sizeof(config), "team n=%d batch=%d", n, batch);
+    double team_time = time_gemm(config, nflops, [&]() {
+        batched_gemm_team(alpha, A, B, beta, C);
+      }, iterations);
+
+    snprintf(config, sizeof(config), "vector n=%d batch=%d", n, batch);
+    double vector_time = time_gemm(config, nflops, [&]() {
+        batched_gemm_vector(alpha, A, B, beta, C);
+      }, iterations);
+
+    printf("%6d %10d %14.2f %14.2f %16.2e\n", n, batch,
+           1.0e-9 * nflops / team_time, 1.0e-9 * nflops / vector_time, diff);
+}
+
+int main(int argc, char** argv) {
+    Kokkos::initialize(argc, argv);
+
+    // Number of iterations
+    int niter = 10;
+
+    // Upper limit for the memory used by the matrices
+    double max_gb = 2.0;
+
+    if (argc > 1) {
+        niter = std::atoi(argv[1]);
+        if (niter < 1) {
+            printf("Number of iterations need to be greater than zero.\n");
+            return 1;
+        }
+    }
+    if (argc > 2) {
+        max_gb = std::atof(argv[2]);
+        if (max_gb <= 0.0) {
+            printf("Memory limit needs to be greater than zero.\n");
+            return 1;
+        }
+    }
+
+    printf("Number of iterations = %d\n", niter);
+    printf("Execution Space: %s\n", Kokkos::DefaultExecutionSpace::name());
+
+    printf("%6s %10s %14s %14s %16s\n", "size", "batch",
+           "team (GF/s)", "vector (GF/s)", "max rel. diff");
+
+    const int sizes[] = {8, 16, 32, 64};
+    const int batches[] = {100, 1000, 10000, 100000};
+    for (int n : sizes) {
+        for (int batch : batches) {
+            // A, B and C plus two copies of C for checking the results
+            double gb = 5.0 * batch * n * n * sizeof(double) * 1.0e-9;
+            if (gb > max_gb) continue;
+            batched_gemm(batch, n, niter);
+        }
+    }
+
+    Kokkos::finalize();
+    return 0;
+}
@@ -0,0 +1,90 @@
+// SPDX-FileCopyrightText: 2026 CSC - IT Center for Science Ltd. <www.csc.fi>
+//
+// SPDX-License-Identifier: MIT
+
+// Batched matrix-matrix products C(b) = alpha * A(b) * B(b) + beta * C(b)
+// for many small matrices stored in rank-3 views (batch, rows, columns)
+//
+// Two ways of mapping the batch to the hardware:
+// - batched_gemm_team: one team per matrix, team threads run over the rows
+//   and vector lanes over the columns of C
+// - batched_gemm_vector: one team thread per matrix, vector lanes run over
+//   all the elements of C
+
+#pragma once
+
+#include <Kokkos_Core.hpp>
+#include <algorithm>
+
+// Smallest power of two >= n that the backend supports as vector length
+template <class Policy>
+int batched_vector_length(const int n)
+{
+  int length = 1;
+  while (length < n && length < Policy::vector_length_max()) length *= 2;
+  return length;
+}
+
+template <class Scalar, class AView, class BView, class CView>
+void batched_gemm_team(const Scalar alpha, const AView &A, const BView &B,
+                       const Scalar beta, const CView &C)
+{
+  using Policy = Kokkos::TeamPolicy<typename CView::execution_space>;
+  using Member = typename Policy::member_type;
+
+  const int batch = C.extent(0);
+  const int M = C.extent(1);
+  const int N = C.extent(2);
+  const int K = A.extent(2);
+
+  Kokkos::parallel_for("batched_gemm_team",
+    Policy(batch, Kokkos::AUTO, batched_vector_length<Policy>(N)),
+    KOKKOS_LAMBDA(const Member &team) {
+      const int b = team.league_rank();
+      Kokkos::parallel_for(Kokkos::TeamThreadRange(team, M), [&](const int i) {
+        Kokkos::parallel_for(Kokkos::ThreadVectorRange(team, N), [&](const int j) {
+          Scalar sum = 0;
+          for (int k = 0; k < K; k++) {
+            sum += A(b, i, k) * B(b, k, j);
+          }
+          C(b, i, j) = alpha * sum + beta * C(b, i, j);
+        });
+      });
+    });
+}
+
+template <class Scalar, class AView, class BView, class CView>
+void batched_gemm_vector(const Scalar alpha, const AView &A, const BView &B,
+                         const Scalar beta, const CView &C)
+{
+  using Policy = Kokkos::TeamPolicy<typename CView::execution_space>;
+  using Member = typename Policy::member_type;
+
+  const int batch = C.extent(0);
+  const int M = C.extent(1);
+  const int N = C.extent(2);
+  const int K = A.extent(2);
+  const int vector_length = batched_vector_length<Policy>(M * N);
+
+  auto kernel = KOKKOS_LAMBDA(const Member &team) {
+    const int b = team.league_rank() * team.team_size() + team.team_rank();
+    if (b >= batch) return;
+    Kokkos::parallel_for(Kokkos::ThreadVectorRange(team, M * N), [&](const int ij) {
+      const int i = ij / N;
+      const int j = ij % N;
+      Scalar sum = 0;
+      for (int k = 0; k < K; k++) {
+        sum += A(b, i, k) * B(b, k, j);
+      }
+      C(b, i, j) = alpha * sum + beta * C(b, i, j);
+    });
+  };
+
+  // A few matrices per team, as many as the backend allows
+  const int team_size = std::min(8, Policy(1, 1, vector_length)
+                                        .team_size_max(kernel, Kokkos::ParallelForTag()));
+  const int league_size = (batch + team_size - 1) / team_size;
+
+  Kokkos::parallel_for("batched_gemm_vector",
+    Policy(league_size, team_size, vector_length), kernel);
+}
@@ -4,7 +4,271 @@
 
 #include <Kokkos_Core.hpp>
 #include <Kokkos_Random.hpp>
+#ifdef HAVE_KOKKOSKERNELS
 #include <KokkosBlas3_gemm.hpp>
+#endif
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+#include "bench.h"
+#include "mdrange_autotune.hpp"
+#include "perf_regions.h"
+#include "tiled_gemm.hpp"
+
+// Median time of a single gemm call over the iterations, after one warm-up
+// call. The statistics are also written to BENCH_OUTPUT if requested.
+// The hardware counters (with -DPERF_COUNTERS) are given per element of C.
+template <class Gemm>
+double time_gemm(const char *config, const double nflops, const double nelements,
+                 const Gemm &gemm, const int iterations) {
+
+    bench_t bench;
+    bench_init(&bench, "gemm", config, 1, iterations);
+
+    for (int iter = 0; iter < bench_total_runs(&bench); iter++) {
+      double t0 = bench_time();
+      PERF_REGION_BEGIN(config);
+      gemm();
+      Kokkos::fence();
+      PERF_REGION_END(config, nelements);
+      bench_add(&bench, bench_time() - t0);
+    }
+
+    bench_stats_t stats = bench_report(&bench, 1.0e-12 * nflops, "TFLOP/s");
+    bench_free(&bench);
+
+    return stats.median;
+}
+
+// Straightforward product for checking the results
+template <class Scalar, class AView, class BView, class CView>
+void reference_gemm(const Scalar alpha, const AView &A, const BView &B,
+                    const Scalar beta, const CView &C) {
+
+    const int K = A.extent(1);
+    Kokkos::parallel_for("reference_gemm",
+      Kokkos::MDRangePolicy<Kokkos::Rank<2>>({0, 0}, {C.extent(0), C.extent(1)}),
+      KOKKOS_LAMBDA(const int i, const int j) {
+        Scalar sum = 0;
+        for (int k = 0; k < K; k++) {
+          sum += A(i, k) * B(k, j);
+        }
+        C(i, j) = alpha * sum + beta * C(i, j);
+    });
+}
+
+// Copy with conversion between scalar types
+template <class ToView, class FromView>
+void convert(const ToView &to, const FromView &from) {
+
+    using Scalar = typename ToView::non_const_value_type;
+    Kokkos::parallel_for("convert",
+      Kokkos::MDRangePolicy<Kokkos::Rank<2>>({0, 0}, {to.extent(0), to.extent(1)}),
+      KOKKOS_LAMBDA(const int i, const int j) {
+        to(i, j) = Scalar(from(i, j));
+    });
+}
+
+// Largest difference relative to the largest element of the reference
+template <class View, class RefView>
+double max_relative_difference(const View &X, const RefView &Xref) {
+
+    double diff = 0.0, scale = 0.0;
+    Kokkos::parallel_reduce("max_difference",
+      Kokkos::MDRangePolicy<Kokkos::Rank<2>>({0, 0}, {X.extent(0), X.extent(1)}),
+      KOKKOS_LAMBDA(const int i, const int j, double &d) {
+        double x = Kokkos::abs(double(X(i, j)) - double(Xref(i, j)));
+        if (x > d) d = x;
+      }, Kokkos::Max<double>(diff));
+    Kokkos::parallel_reduce("max_reference",
+      Kokkos::MDRangePolicy<Kokkos::Rank<2>>({0, 0}, {X.extent(0), X.extent(1)}),
+      KOKKOS_LAMBDA(const int i, const int j, double &s) {
+        double x = Kokkos::abs(double(Xref(i, j)));
+        if (x > s) s = x;
+      }, Kokkos::Max<double>(scale));
+
+    return scale > 0.0 ? diff / scale : diff;
+}
+
+// Check and time the implementations with matrices stored as Scalar and
+// products accumulated as Acc, starting from the given double precision
+// input and comparing to the double precision reference result Cref
+template <class Scalar, class Acc = Scalar, class View>
+void benchmark_precision(const char *matrices, const char *precision,
+                         const double alpha, const View &A, const View &B, const double beta,
+                         const View &C, const View &Cref, const int iterations) {
+
+    const int M = C.extent(0);
+    const int N = C.extent(1);
+    const int K = A.extent(1);
+    const double nflops = 2.0 * M * N * K;
+
+    Kokkos::View<Scalar**> As("As", M, K);
+    Kokkos::View<Scalar**> Bs("Bs", K, N);
+    Kokkos::View<Scalar**> Cs("Cs", M, N);
+    Kokkos::View<Scalar**> Ctest("Ctest", M, N);
+    convert(As, A);
+    convert(Bs, B);
+    convert(Cs, C);
+    const Scalar a = alpha;
+    const Scalar b = beta;
+
+    char config[256];
+
+#ifdef HAVE_KOKKOSKERNELS
+    if constexpr (std::is_same_v<Scalar, Acc>) {
+      Kokkos::deep_copy(Ctest, Cs);
+      KokkosBlas::gemm("N", "N", a, As, Bs, b, Ctest);
+      double blas_error = max_relative_difference(Ctest, Cref);
+
+      snprintf(config, sizeof(config), "KokkosBlas::gemm %s %s M=%d N=%d K=%d",
+               precision, matrices, M, N, K);
+      double blas_time = time_gemm(config, nflops, 1.0 * M * N, [&]() {
+          KokkosBlas::gemm("N", "N", a, As, Bs, b, Cs);
+        }, iterations);
+      printf("  %-18s %-14s %10.4f %16.2e\n",
+             "KokkosBlas::gemm", precision, 1.0e-12 * nflops / blas_time, blas_error);
+      convert(Cs, C);
+    }
+#endif
+
+    Kokkos::deep_copy(Ctest, Cs);
+    tiled_gemm<Scalar, Acc>(a, As, Bs, b, Ctest);
+    double tiled_error = max_relative_difference(Ctest, Cref);
+
+    snprintf(config, sizeof(config), "tiled_gemm %s %s M=%d N=%d K=%d",
+             precision, matrices, M, N, K);
+    double tiled_time = time_gemm(config, nflops, 1.0 * M * N, [&]() {
+        tiled_gemm<Scalar, Acc>(a, As, Bs, b, Cs);
+      }, iterations);
+    printf("  %-18s %-14s %10.4f %16.2e\n",
+           "tiled_gemm", precision, 1.0e-12 * nflops / tiled_time, tiled_error);
+}
+
+// Check and time all the implementations and precisions with the same input matrices
+template <class View>
+void benchmark(const char *matrices, const double alpha, const View &A, const View &B,
+               const double beta, const View &C, const int iterations) {
+
+    View Cref("Cref", C.extent(0), C.extent(1));
+    Kokkos::deep_copy(Cref, C);
+    reference_gemm(alpha, A, B, beta, Cref);
+
+    std::cout << "Performance with " << matrices << " matrices:" << std::endl;
+    printf("  %-18s %-14s %10s %16s\n", "implementation", "precision", "TF/s", "max rel. error");
+
+    benchmark_precision<double>(matrices, "double", alpha, A, B, beta, C, Cref, iterations);
+    benchmark_precision<float>(matrices, "float", alpha, A, B, beta, C, Cref, iterations);
+    benchmark_precision<float, double>(matrices, "float+double", alpha, A, B, beta, C, Cref, iterations);
+}
+
+// Transposed matrix without copying: the same data with swapped extents
+// and the other layout
+template <class View>
+auto transposed(const View &A) {
+
+    using Layout = std::conditional_t<
+      std::is_same_v<typename View::array_layout, Kokkos::LayoutLeft>,
+      Kokkos::LayoutRight, Kokkos::LayoutLeft>;
+    return Kokkos::View<typename View::value_type**, Layout, typename View::memory_space,
+                        Kokkos::MemoryTraits<Kokkos::Unmanaged>>(A.data(), A.extent(1), A.extent(0));
+}
+
+// Benchmark suite over rectangular shapes and transpose combinations
+// The results are written in CSV format together with the arithmetic
+// intensity (flops per byte of A, B and C moved once) and the resulting
+// roofline bound if the peak performance and bandwidth are given
+void sweep(const int n, const int iterations, const double peak_tflops, const double peak_gbs) {
+
+    struct Shape { const char *name; int M, N, K; };
+    const Shape shapes[] = {
+      {"square",      n,                   n,                   n},
+      {"tall-skinny", 8 * n,               std::max(n / 8, 1),  n},
+      {"short-wide",  std::max(n / 8, 1),  8 * n,               n},
+      {"tall-thin",   16 * n,              32,                  32},
+      {"low-rank",    n,                   n,                   std::max(n / 16, 1)},
+      {"long-inner",  std::max(n / 8, 1),  std::max(n / 8, 1),  16 * n},
+    };
+
+    const char *filename = "gemm_sweep.csv";
+    FILE *csv = fopen(filename, "w");
+    if (csv == NULL) {
+      perror("Failed to open file");
+      return;
+    }
+
+    const char *header = "implementation,shape,transA,transB,M,N,K,time_s,tflops,"
+                         "arithmetic_intensity,roofline_tflops,fraction_of_roofline\n";
+    fputs(header, csv);
+    fputs(header, stdout);
+
+    const double alpha = 1.234567;
+    const double beta = 0.89987234;
+    Kokkos::Random_XorShift64_Pool<> random_pool(12345);
+
+    for (const auto &shape : shapes) {
+      for (int ta = 0; ta < 2; ta++) {
+        for (int tb = 0; tb < 2; tb++) {
+
+          const int M = shape.M, N = shape.N, K = shape.K;
+
+          // Stored matrices, op(A) is M x K and op(B) is K x N
+          Kokkos::View<double**> A("A", ta ? K : M, ta ? M : K);
+          Kokkos::View<double**> B("B", tb ? N : K, tb ? K : N);
+          Kokkos::View<double**> C("C", M, N);
+          Kokkos::fill_random(A, random_pool, -100.0, 100.0);
+          Kokkos::fill_random(B, random_pool, -100.0, 100.0);
+          Kokkos::fill_random(C, random_pool, -100.0, 100.0);
+
+          const double nflops = 2.0 * M * N * K;
+          const double nbytes = sizeof(double) * (1.0 * M * K + 1.0 * K * N + 2.0 * M * N);
+          const double intensity = nflops / nbytes;
+          const double roofline = (peak_tflops > 0.0 && peak_gbs > 0.0)
+                                ? std::min(peak_tflops, 1.0e-3 * peak_gbs * intensity) : 0.0;
+
+          auto report = [&](const char *implementation, const double time) {
+            const double tflops = 1.0e-12 * nflops / time;
+            char line[256];
+            snprintf(line, sizeof(line), "%s,%s,%c,%c,%d,%d,%d,%.6e,%.4f,%.2f,%.4f,%.3f\n",
+                     implementation, shape.name, ta ? 'T' : 'N', tb ? 'T' : 'N', M, N, K,
+                     time, tflops, intensity, roofline, roofline > 0.0 ? tflops / roofline : 0.0);
+            fputs(line, csv);
+            fputs(line, stdout);
+          };
+
+          char config[256];
+          auto label = [&](const char *implementation) {
+            snprintf(config, sizeof(config), "%s %s %c%c M=%d N=%d K=%d", implementation,
+                     shape.name, ta ? 'T' : 'N', tb ? 'T' : 'N', M, N, K);
+            return config;
+          };
+
+#ifdef HAVE_KOKKOSKERNELS
+          report("KokkosBlas::gemm", time_gemm(label("KokkosBlas::gemm"), nflops, 1.0 * M * N,
+            [&]() {
+              KokkosBlas::gemm(ta ? "T" : "N", tb ? "T" : "N", alpha, A, B, beta, C);
+            }, iterations));
+#endif
+
+          auto time_tiled = [&](const auto &opA, const auto &opB) {
+            return time_gemm(label("tiled_gemm"), nflops, 1.0 * M * N, [&]() {
+                tiled_gemm(alpha, opA, opB, beta, C);
+              }, iterations);
+          };
+          double tiled_time;
+          if (ta && tb) tiled_time = time_tiled(transposed(A), transposed(B));
+          else if (ta)  tiled_time = time_tiled(transposed(A), B);
+          else if (tb)  tiled_time = time_tiled(A, transposed(B));
+          else          tiled_time = time_tiled(A, B);
+          report("tiled_gemm", tiled_time);
+        }
+      }
+    }
+
+    fclose(csv);
+    std::cout << "Results written to " << filename << std::endl;
+}
 
 void gemm(const int M, const int N, const int K, const int iterations) {
 
@@ -22,25 +286,7 @@ void gemm(const int M, const int N, const int K, const int iterations) {
     Kokkos::fill_random(B, random_pool, -100.0, 100.0);
     Kokkos::fill_random(C, random_pool, -100.0, 100.0);
 
-    Kokkos::Timer timer;
-    double gemm_time;
-
-    for (int iter = 0; iter<=iterations; iter++) {
-
-      // One warm-up iteration
-      if (iter==1) gemm_time = timer.seconds();
-
-      KokkosBlas::gemm("N", "N", alpha, A, B, beta, C);
-      Kokkos::fence();
-
-    }
-
-    gemm_time = timer.seconds() - gemm_time;
-
-    double avgtime = gemm_time / (double) iterations;
-    double nflops = 2.0 * M * N * K;
-    std::cout << "Performance with random matrices (TF/s): " << 1.0e-12 * nflops/avgtime
-              << std::endl;
+    benchmark("random", alpha, A, B, beta, C, iterations);
 
 
     // Fill matrices with "nice" integers
@@ -51,37 +297,24 @@ void gemm(const int M, const int N, const int K, const int iterations) {
     alpha = 2.0;
     beta = 3.0;
 
-    Kokkos::parallel_for("Init_A", Kokkos::MDRangePolicy<Kokkos::Rank<2>>({0, 0}, {M, K}),
+    mdrange_autotune::parallel_for("Init_A", {0, 0}, {M, K},
       KOKKOS_LAMBDA(const int i, const int j) {
         A(i, j) = i + j;
     });
 
-    Kokkos::parallel_for("Init_B", Kokkos::MDRangePolicy<Kokkos::Rank<2>>({0, 0}, {K, N}),
+    mdrange_autotune::parallel_for("Init_B", {0, 0}, {K, N},
       KOKKOS_LAMBDA(const int i, const int j) {
         B(i, j) = 4*j - 2*i;
     });
 
-    Kokkos::parallel_for("Init_C", Kokkos::MDRangePolicy<Kokkos::Rank<2>>({0, 0}, {M, N}),
+    mdrange_autotune::parallel_for("Init_C", {0, 0}, {M, N},
       KOKKOS_LAMBDA(const int i, const int j) {
         C(i, j) = i - j;
     });
 
-    for (int iter = 0; iter<=iterations; iter++) {
-
-      // One warm-up iteration
-      if (iter==1) gemm_time = timer.seconds();
-
-      KokkosBlas::gemm("N", "N", alpha, A, B, beta, C);
-      Kokkos::fence();
-
-    }
-
-    gemm_time = timer.seconds() - gemm_time;
+    benchmark("integer", alpha, A, B, beta, C, iterations);
 
-    avgtime = gemm_time / (double) iterations;
-    nflops = 2.0 * M * N * K;
-    std::cout << "Performance with integer matrices (TF/s): " << 1.0e-12 * nflops/avgtime
-              << std::endl;
+    mdrange_autotune::report();
 }
 
 int main(int argc, char** argv) {
@@ -89,9 +322,12 @@ int main(int argc, char** argv) {
 
     int niter;
     int n;
+    bool run_sweep = false;
+    double peak_tflops = 0.0;
+    double peak_gbs = 0.0;
     try {
-        if (argc < 2) {
-          throw "Usage: <# iterations> <matrix order>";
+        if (argc < 3) {
+          throw "Usage: <# iterations> <matrix order> [sweep [<peak TF/s> <peak GB/s>]]";
         }
 
         niter  = std::atoi(argv[1]);
@@ -103,6 +339,24 @@ int main(int argc, char** argv) {
         if (n <= 0) {
           throw "ERROR: Matrix Order must be greater than 0";
         }
+
+        if (argc > 3) {
+          if (std::strcmp(argv[3], "sweep") != 0) {
+            throw "ERROR: unknown mode, only 'sweep' is supported";
+          }
+          run_sweep = true;
+        }
+        if (argc == 5) {
+          std::cout << "ERROR: give both <peak TF/s> and <peak GB/s>" << std::endl;
+          throw "Usage: <# iterations> <matrix order> [sweep [<peak TF/s> <peak GB/s>]]";
+        }
+        if (argc > 5) {
+          peak_tflops = std::atof(argv[4]);
+          peak_gbs = std::atof(argv[5]);
+          if (peak_tflops <= 0.0 || peak_gbs <= 0.0) {
+            throw "ERROR: peak performance and bandwidth must be greater than 0";
+          }
+        }
     }
     catch (const char * e) {
       std::cout << e << std::endl;
@@ -117,13 +371,16 @@ int main(int argc, char** argv) {
     std::cout << "Memory Space: " <<
       Kokkos::DefaultExecutionSpace::memory_space::name() << std::endl;
 
-    const int M = n;
-    const int N = n;
-    const int K = n;
+    if (run_sweep) {
+      sweep(n, niter, peak_tflops, peak_gbs);
+    } else {
+      const int M = n;
+      const int N = n;
+      const int K = n;
 
-    gemm(M, N, K, niter);
+      gemm(M, N, K, niter);
+    }
 
     Kokkos::finalize();
     return 0;
 }
-
@@ -0,0 +1 @@
+../../mdrange_autotune.hpp
\ No newline at end of file
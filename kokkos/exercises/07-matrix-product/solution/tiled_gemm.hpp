@@ -0,0 +1,130 @@
+// SPDX-FileCopyrightText: 2026 CSC - IT Center for Science Ltd. <www.csc.fi>
+//
+// SPDX-License-Identifier: MIT
+
+// General matrix-matrix product C = alpha * A * B + beta * C
+// with hierarchical parallelism
+//
+// Each team computes one TILE_M x TILE_N tile of C. The tiles of A and B
+// are staged through team scratch memory in steps of TILE_K. Within the
+// team, each thread owns REG_M rows of the tile and the vector lanes run
+// over the columns, so that every value of B read from scratch is reused
+// REG_M times from registers. The team has TILE_M / REG_M threads, or as
+// many as the backend supports for this kernel (e.g. fewer on a host with
+// few threads), in which case the threads loop over the rows.
+//
+// The products are accumulated in type Acc, which can be wider than the
+// storage type Scalar (e.g. float matrices with double accumulation).
+
+#pragma once
+
+#include <Kokkos_Core.hpp>
+#include <algorithm>
+#include <stdexcept>
+
+template <class Scalar, class Acc = Scalar,
+          int TILE_M = 32, int TILE_N = 32, int TILE_K = 32, int REG_M = 4,
+          class AView, class BView, class CView>
+void tiled_gemm(const Scalar alpha, const AView &A, const BView &B,
+                const Scalar beta, const CView &C)
+{
+  static_assert(TILE_M % REG_M == 0, "TILE_M must be a multiple of REG_M");
+
+  using ExecSpace = typename CView::execution_space;
+  using Policy = Kokkos::TeamPolicy<ExecSpace>;
+  using Member = typename Policy::member_type;
+  using ScratchTile = Kokkos::View<Scalar**, typename ExecSpace::scratch_memory_space,
+                                   Kokkos::MemoryTraits<Kokkos::Unmanaged>>;
+  using ScratchAccTile = Kokkos::View<Acc**, typename ExecSpace::scratch_memory_space,
+                                      Kokkos::MemoryTraits<Kokkos::Unmanaged>>;
+
+  const int M = C.extent(0);
+  const int N = C.extent(1);
+  const int K = A.extent(1);
+
+  const int tiles_m = (M + TILE_M - 1) / TILE_M;
+  const int tiles_n = (N + TILE_N - 1) / TILE_N;
+
+  const size_t scratch_size = ScratchTile::shmem_size(TILE_M, TILE_K)
+                            + ScratchTile::shmem_size(TILE_K, TILE_N)
+                            + ScratchAccTile::shmem_size(TILE_M, TILE_N);
+
+  auto kernel = KOKKOS_LAMBDA(const Member &team) {
+    const int i0 = (team.league_rank() / tiles_n) * TILE_M;
+    const int j0 = (team.league_rank() % tiles_n) * TILE_N;
+
+    ScratchTile As(team.team_scratch(0), TILE_M, TILE_K);
+    ScratchTile Bs(team.team_scratch(0), TILE_K, TILE_N);
+    ScratchAccTile Cs(team.team_scratch(0), TILE_M, TILE_N);
+
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(team, TILE_M), [&](const int i) {
+      Kokkos::parallel_for(Kokkos::ThreadVectorRange(team, TILE_N), [&](const int j) {
+        Cs(i, j) = 0;
+      });
+    });
+    team.team_barrier();
+
+    for (int k0 = 0; k0 < K; k0 += TILE_K) {
+
+      // Stage the tiles of A and B, padding with zeros at the edges
+      Kokkos::parallel_for(Kokkos::TeamThreadRange(team, TILE_M), [&](const int i) {
+        Kokkos::parallel_for(Kokkos::ThreadVectorRange(team, TILE_K), [&](const int k) {
+          As(i, k) = (i0 + i < M && k0 + k < K) ? A(i0 + i, k0 + k) : Scalar(0);
+        });
+      });
+      Kokkos::parallel_for(Kokkos::TeamThreadRange(team, TILE_K), [&](const int k) {
+        Kokkos::parallel_for(Kokkos::ThreadVectorRange(team, TILE_N), [&](const int j) {
+          Bs(k, j) = (k0 + k < K && j0 + j < N) ? B(k0 + k, j0 + j) : Scalar(0);
+        });
+      });
+      team.team_barrier();
+
+      // Register blocking: REG_M rows per thread, one column per vector lane
+      Kokkos::parallel_for(Kokkos::TeamThreadRange(team, TILE_M / REG_M), [&](const int r) {
+        Kokkos::parallel_for(Kokkos::ThreadVectorRange(team, TILE_N), [&](const int j) {
+          Acc c[REG_M];
+          for (int m = 0; m < REG_M; m++) {
+            c[m] = Cs(r * REG_M + m, j);
+          }
+          for (int k = 0; k < TILE_K; k++) {
+            const Acc b = Bs(k, j);
+            for (int m = 0; m < REG_M; m++) {
+              c[m] += Acc(As(r * REG_M + m, k)) * b;
+            }
+          }
+          for (int m = 0; m < REG_M; m++) {
+            Cs(r * REG_M + m, j) = c[m];
+          }
+        });
+      });
+      team.team_barrier();
+    }
+
+    // Scale and write back the tile of C
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(team, TILE_M), [&](const int i) {
+      Kokkos::parallel_for(Kokkos::ThreadVectorRange(team, TILE_N), [&](const int j) {
+        if (i0 + i < M && j0 + j < N) {
+          if (beta == Scalar(0)) {
+            C(i0 + i, j0 + j) = Scalar(Acc(alpha) * Cs(i, j));
+          } else {
+            C(i0 + i, j0 + j) = Scalar(Acc(alpha) * Cs(i, j)
+                                       + Acc(beta) * Acc(C(i0 + i, j0 + j)));
+          }
+        }
+      });
+    });
+  };
+
+  const int vector_length = std::min(TILE_N, Policy::vector_length_max());
+  Policy probe(tiles_m * tiles_n, 1, vector_length);
+  probe.set_scratch_size(0, Kokkos::PerTeam(scratch_size));
+  const int team_size = std::min(TILE_M / REG_M,
+                                 probe.team_size_max(kernel, Kokkos::ParallelForTag()));
+  if (team_size < 1) {
+    throw std::runtime_error("tiled_gemm: the backend does not support a team for this kernel");
+  }
+
+  Policy policy(tiles_m * tiles_n, team_size, vector_length);
+  policy.set_scratch_size(0, Kokkos::PerTeam(scratch_size));
+  Kokkos::parallel_for("tiled_gemm", policy, kernel);
+}
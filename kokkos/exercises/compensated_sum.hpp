@@ -0,0 +1,94 @@
+// SPDX-FileCopyrightText: 2026 CSC - IT Center for Science Ltd. <www.csc.fi>
+//
+// SPDX-License-Identifier: MIT
+
+// Compensated (Kahan-Babuska-Neumaier) sums for Kokkos::parallel_reduce
+//
+// The rounding error of every addition is computed exactly and collected
+// into a separate compensation term:
+//
+//   compensated::Value sum;
+//   Kokkos::parallel_reduce(n, KOKKOS_LAMBDA(const int64_t i, compensated::Value &s) {
+//     s.add(x(i) * y(i));
+//   }, compensated::Sum<Kokkos::HostSpace>(sum));
+//   double dot = sum.result();
+//
+// The error is about one rounding of the result plus n * eps^2 * sum(|x|),
+// compared to n * eps * sum(|x|) for the plain sum. The algorithm is the
+// same as in openmp/exercises/compensated_sum.h.
+// Note! Do not compile with -ffast-math, it removes the compensation.
+
+#pragma once
+
+#include <Kokkos_Core.hpp>
+#include <cstdint>
+#include <string>
+
+#if defined(__FAST_MATH__)
+#error "compensated_sum.hpp does not work with -ffast-math"
+#endif
+
+namespace compensated {
+
+struct Value {
+  double sum = 0.0;
+  double c = 0.0;  // rounding errors of sum
+
+  KOKKOS_INLINE_FUNCTION void add(const double x)
+  {
+    const double t = sum + x;
+    // Exact rounding error of t, computed from the larger operand
+    if (Kokkos::fabs(sum) >= Kokkos::fabs(x)) {
+      c += (sum - t) + x;
+    } else {
+      c += (x - t) + sum;
+    }
+    sum = t;
+  }
+
+  KOKKOS_INLINE_FUNCTION double result() const { return sum + c; }
+};
+
+// Custom reducer combining the partial sums and their compensations
+template <class Space>
+class Sum {
+public:
+  using reducer = Sum;
+  using value_type = Value;
+  using result_view_type = Kokkos::View<value_type, Space, Kokkos::MemoryUnmanaged>;
+
+  KOKKOS_INLINE_FUNCTION Sum(value_type &value) : value_(&value) {}
+
+  KOKKOS_INLINE_FUNCTION void join(value_type &dest, const value_type &src) const
+  {
+    dest.add(src.sum);
+    dest.c += src.c;
+  }
+
+  KOKKOS_INLINE_FUNCTION void init(value_type &value) const
+  {
+    value.sum = 0.0;
+    value.c = 0.0;
+  }
+
+  KOKKOS_INLINE_FUNCTION value_type &reference() const { return *value_.data(); }
+  KOKKOS_INLINE_FUNCTION result_view_type view() const { return value_; }
+  KOKKOS_INLINE_FUNCTION bool references_scalar() const { return true; }
+
+private:
+  result_view_type value_;
+};
+
+// Compensated sum of f(i) for i = 0, ..., n-1
+template <class F>
+double parallel_sum(const std::string &label, const int64_t n, const F &f)
+{
+  Value sum;
+  Kokkos::parallel_reduce(label, Kokkos::RangePolicy<>(0, n),
+    KOKKOS_LAMBDA (const int64_t i, Value &s) {
+      s.add(f(i));
+    }, Sum<Kokkos::HostSpace>(sum));
+  return sum.result();
+}
+
+} // namespace compensated
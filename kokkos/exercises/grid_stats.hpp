@@ -0,0 +1,122 @@
+// SPDX-FileCopyrightText: 2026 CSC - IT Center for Science Ltd. <www.csc.fi>
+//
+// SPDX-License-Identifier: MIT
+
+// Statistics of a 2D field per quadrant, computed in a single pass
+//
+// Count, sum, sum of squares, minimum and maximum of all four quadrants
+// are collected with one custom reducer, so u is read only once:
+//
+//   grid_stats::Value stats;
+//   Kokkos::parallel_reduce(policy, KOKKOS_LAMBDA(const int i, const int j, grid_stats::Value &s) {
+//     s.add(grid_stats::quadrant(i, j, nx, ny), u(i, j));
+//   }, grid_stats::QuadrantStats<Kokkos::HostSpace>(stats));
+//
+// The quadrants are numbered 0: i < nx/2, j < ny/2, 1: i < nx/2, j >= ny/2,
+// 2: i >= nx/2, j < ny/2, and 3: i >= nx/2, j >= ny/2. The OpenMP version
+// is in openmp/exercises/heat_stats.h.
+
+#pragma once
+
+#include <Kokkos_Core.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <cmath>
+
+namespace grid_stats {
+
+constexpr int nquadrant = 4;
+
+struct Stat {
+  int64_t count;
+  double sum;   // sum of u
+  double sum2;  // sum of u^2
+  double min;
+  double max;
+};
+
+struct Value {
+  Stat q[nquadrant];
+
+  KOKKOS_INLINE_FUNCTION void add(const int quadrant, const double u)
+  {
+    Stat &s = q[quadrant];
+    s.count++;
+    s.sum += u;
+    s.sum2 += u * u;
+    s.min = Kokkos::fmin(s.min, u);
+    s.max = Kokkos::fmax(s.max, u);
+  }
+
+  // All quadrants together
+  KOKKOS_INLINE_FUNCTION Stat total() const
+  {
+    Stat all = q[0];
+    for (int k = 1; k < nquadrant; k++) {
+      all.count += q[k].count;
+      all.sum += q[k].sum;
+      all.sum2 += q[k].sum2;
+      all.min = Kokkos::fmin(all.min, q[k].min);
+      all.max = Kokkos::fmax(all.max, q[k].max);
+    }
+    return all;
+  }
+};
+
+KOKKOS_INLINE_FUNCTION int quadrant(const int i, const int j, const int nx, const int ny)
+{
+  return 2 * (i >= nx / 2) + (j >= ny / 2);
+}
+
+// Custom reducer combining the statistics of all quadrants
+template <class Space>
+class QuadrantStats {
+public:
+  using reducer = QuadrantStats;
+  using value_type = Value;
+  using result_view_type = Kokkos::View<value_type, Space, Kokkos::MemoryUnmanaged>;
+
+  KOKKOS_INLINE_FUNCTION QuadrantStats(value_type &value) : value_(&value) {}
+
+  KOKKOS_INLINE_FUNCTION void join(value_type &dest, const value_type &src) const
+  {
+    for (int k = 0; k < nquadrant; k++) {
+      dest.q[k].count += src.q[k].count;
+      dest.q[k].sum += src.q[k].sum;
+      dest.q[k].sum2 += src.q[k].sum2;
+      dest.q[k].min = Kokkos::fmin(dest.q[k].min, src.q[k].min);
+      dest.q[k].max = Kokkos::fmax(dest.q[k].max, src.q[k].max);
+    }
+  }
+
+  KOKKOS_INLINE_FUNCTION void init(value_type &value) const
+  {
+    for (int k = 0; k < nquadrant; k++) {
+      value.q[k].count = 0;
+      value.q[k].sum = 0.0;
+      value.q[k].sum2 = 0.0;
+      value.q[k].min = Kokkos::Experimental::finite_max_v<double>;
+      value.q[k].max = Kokkos::Experimental::finite_min_v<double>;
+    }
+  }
+
+  KOKKOS_INLINE_FUNCTION value_type &reference() const { return *value_.data(); }
+  KOKKOS_INLINE_FUNCTION result_view_type view() const { return value_; }
+  KOKKOS_INLINE_FUNCTION bool references_scalar() const { return true; }
+
+private:
+  result_view_type value_;
+};
+
+// Mean of each quadrant, followed by the minimum, maximum and L2 norm
+// (sqrt of the sum of u^2 times the cell area) over all quadrants
+inline void print(const Value &stats, const double cell_area = 1.0)
+{
+  const Stat all = stats.total();
+  printf("Quadrant means: %+9.4f  %+9.4f  %+9.4f  %+9.4f  min %+9.4f  max %+9.4f  L2 %9.4f\n",
+         stats.q[0].sum / stats.q[0].count, stats.q[1].sum / stats.q[1].count,
+         stats.q[2].sum / stats.q[2].count, stats.q[3].sum / stats.q[3].count,
+         all.min, all.max, std::sqrt(all.sum2 * cell_area));
+}
+
+} // namespace grid_stats
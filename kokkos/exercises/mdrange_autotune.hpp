@@ -0,0 +1,293 @@
+// SPDX-FileCopyrightText: 2026 CSC - IT Center for Science Ltd. <www.csc.fi>
+//
+// SPDX-License-Identifier: MIT
+
+// Tile size autotuning for rank-2 MDRangePolicy kernels
+//
+// The first time a kernel is launched for given (label, extents), it is
+// timed with the default tiling and with a set of candidate tile shapes.
+// The fastest choice is appended to a cache file (mdrange_tiles.txt by
+// default, can be changed with the MDRANGE_TILE_CACHE environment variable)
+// and reused on later calls and later runs.
+//
+// Note! During tuning the kernel is executed 4 times with the default tiling
+// and 4 times with each candidate tile shape, so the functor must be
+// idempotent: it must give the same result when run repeatedly (i.e., no
+// in-place updates or accumulation into its output).
+//
+// To keep the tuning out of timed regions, call tune() with the same label,
+// range and functor before the timer starts; the later launches then only
+// look up the tile.
+
+#pragma once
+
+#include <Kokkos_Core.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mdrange_autotune {
+
+using Point = std::array<int64_t, 2>;
+using Policy = Kokkos::MDRangePolicy<Kokkos::Rank<2>>;
+
+struct Entry {
+  std::string space;
+  std::string label;
+  Point extents;
+  Point tile;               // {0, 0} = Kokkos default tiling
+  double default_time;      // seconds per launch with default tiling
+  double tuned_time;        // seconds per launch with the selected tiling
+  bool from_cache;
+  bool used;
+};
+
+inline std::string cache_filename()
+{
+  const char *env = std::getenv("MDRANGE_TILE_CACHE");
+  return env ? env : "mdrange_tiles.txt";
+}
+
+// Labels are stored as whitespace separated fields
+inline std::string sanitize(std::string s)
+{
+  std::replace(s.begin(), s.end(), ' ', '_');
+  return s;
+}
+
+inline std::vector<Entry> load_cache(const std::string &filename)
+{
+  std::vector<Entry> entries;
+  std::ifstream file(filename);
+  std::string line;
+  while (std::getline(file, line)) {
+    if (line.empty() || line[0] == '#') continue;
+    std::istringstream fields(line);
+    Entry e;
+    if (fields >> e.space >> e.label >> e.extents[0] >> e.extents[1]
+               >> e.tile[0] >> e.tile[1] >> e.default_time >> e.tuned_time) {
+      e.from_cache = true;
+      e.used = false;
+      entries.push_back(e);
+    }
+  }
+  return entries;
+}
+
+inline std::vector<Entry> &cache()
+{
+  static std::vector<Entry> entries = load_cache(cache_filename());
+  return entries;
+}
+
+inline const std::string &space_name()
+{
+  static const std::string name = Kokkos::DefaultExecutionSpace::name();
+  return name;
+}
+
+// Tiles already selected in this run, by the label as given to the launch
+struct Selected {
+  Point extents;
+  Point tile;
+};
+
+inline std::unordered_map<std::string, std::vector<Selected>> &selected()
+{
+  static std::unordered_map<std::string, std::vector<Selected>> tiles;
+  return tiles;
+}
+
+inline void append_to_cache_file(const Entry &e)
+{
+  const std::string filename = cache_filename();
+  const bool is_new = !std::ifstream(filename).good();
+  FILE *file = fopen(filename.c_str(), "a");
+  if (file == NULL) {
+    perror("Failed to open tile cache file");
+    return;
+  }
+  if (is_new) {
+    fprintf(file, "# space label extent0 extent1 tile0 tile1 default_s tuned_s\n");
+  }
+  fprintf(file, "%s %s %lld %lld %lld %lld %.6e %.6e\n",
+          e.space.c_str(), e.label.c_str(),
+          (long long)e.extents[0], (long long)e.extents[1],
+          (long long)e.tile[0], (long long)e.tile[1],
+          e.default_time, e.tuned_time);
+  fclose(file);
+}
+
+// Powers of two up to the extent in each direction, limited by the total
+// tile size the backend supports (e.g. threads per block on GPUs)
+inline std::vector<Point> candidate_tiles(const Point &extents, const int max_total)
+{
+  const int64_t max_tile = std::min<int64_t>(max_total, 1024);
+  std::vector<Point> tiles;
+  for (int64_t t0 = 1; t0 <= max_tile; t0 *= 2) {
+    for (int64_t t1 = 1; t0 * t1 <= max_tile; t1 *= 2) {
+      if (t0 * t1 < std::min<int64_t>(16, max_tile)) continue;
+      if (t0 > 2 * extents[0] || t1 > 2 * extents[1]) continue;
+      tiles.push_back({t0, t1});
+    }
+  }
+  return tiles;
+}
+
+inline Policy make_policy(const Point &begin, const Point &end, const Point &tile)
+{
+  return Policy({begin[0], begin[1]}, {end[0], end[1]}, {tile[0], tile[1]});
+}
+
+// Best time out of a few launches, after one warm-up launch
+template <class Launch>
+double time_launch(const Launch &launch, const Policy &policy, const int nrep = 3)
+{
+  launch(policy);
+  Kokkos::fence();
+
+  Kokkos::Timer timer;
+  double best = std::numeric_limits<double>::max();
+  for (int r = 0; r < nrep; r++) {
+    double t0 = timer.seconds();
+    launch(policy);
+    Kokkos::fence();
+    best = std::min(best, timer.seconds() - t0);
+  }
+  return best;
+}
+
+// Tile from the cache file, or tuned now
+template <class Launch>
+Point lookup_or_tune(const std::string &label, const Point &begin, const Point &end,
+                     const Launch &launch)
+{
+  const std::string &space = space_name();
+  const std::string key = sanitize(label);
+  const Point extents = {end[0] - begin[0], end[1] - begin[1]};
+
+  for (auto &e : cache()) {
+    if (e.space == space && e.label == key && e.extents == extents) {
+      e.used = true;
+      return e.tile;
+    }
+  }
+
+  Entry e;
+  e.space = space;
+  e.label = key;
+  e.extents = extents;
+  e.tile = {0, 0};
+  e.default_time = time_launch(launch, make_policy(begin, end, e.tile));
+  e.tuned_time = e.default_time;
+  e.from_cache = false;
+  e.used = true;
+
+  const int max_total = make_policy(begin, end, e.tile).max_total_tile_size();
+  for (const auto &tile : candidate_tiles(extents, max_total)) {
+    double t = time_launch(launch, make_policy(begin, end, tile));
+    if (t < e.tuned_time) {
+      e.tuned_time = t;
+      e.tile = tile;
+    }
+  }
+
+  append_to_cache_file(e);
+  cache().push_back(e);
+  return e.tile;
+}
+
+template <class Launch>
+Point tuned_tile(const std::string &label, const Point &begin, const Point &end,
+                 const Launch &launch)
+{
+  const Point extents = {end[0] - begin[0], end[1] - begin[1]};
+  auto &tiles = selected()[label];
+  for (const auto &t : tiles) {
+    if (t.extents == extents) {
+      return t.tile;
+    }
+  }
+  const Point tile = lookup_or_tune(label, begin, end, launch);
+  tiles.push_back({extents, tile});
+  return tile;
+}
+
+// Drop-in replacements for Kokkos::parallel_for and Kokkos::parallel_reduce
+// with a rank-2 MDRangePolicy({begin}, {end}). The first launch of each
+// label and range runs the functor many times (see above).
+template <class Functor>
+void parallel_for(const std::string &label, const Point &begin, const Point &end,
+                  const Functor &functor)
+{
+  auto launch = [&](const Policy &policy) {
+    Kokkos::parallel_for(label, policy, functor);
+  };
+  launch(make_policy(begin, end, tuned_tile(label, begin, end, launch)));
+}
+
+template <class Functor, class ReturnType>
+void parallel_reduce(const std::string &label, const Point &begin, const Point &end,
+                     const Functor &functor, ReturnType &&result)
+{
+  auto launch = [&](const Policy &policy) {
+    Kokkos::parallel_reduce(label, policy, functor, result);
+  };
+  launch(make_policy(begin, end, tuned_tile(label, begin, end, launch)));
+}
+
+// Select the tile for a later parallel_for or parallel_reduce, without the
+// final launch
+template <class Functor>
+void tune(const std::string &label, const Point &begin, const Point &end,
+          const Functor &functor)
+{
+  auto launch = [&](const Policy &policy) {
+    Kokkos::parallel_for(label, policy, functor);
+  };
+  tuned_tile(label, begin, end, launch);
+}
+
+template <class Functor, class ReturnType>
+void tune(const std::string &label, const Point &begin, const Point &end,
+          const Functor &functor, ReturnType &&result)
+{
+  auto launch = [&](const Policy &policy) {
+    Kokkos::parallel_reduce(label, policy, functor, result);
+  };
+  tuned_tile(label, begin, end, launch);
+}
+
+// Print the gain of the selected tiling for each kernel used in this run
+inline void report()
+{
+  printf("MDRange tile autotuning (%s, cache %s):\n",
+         space_name().c_str(), cache_filename().c_str());
+  printf("  %-12s %13s %10s %13s %13s %8s\n",
+         "kernel", "extents", "tile", "default (ms)", "tuned (ms)", "speedup");
+  for (const auto &e : cache()) {
+    if (!e.used) continue;
+    char extents[32], tile[32];
+    snprintf(extents, sizeof(extents), "%lldx%lld",
+             (long long)e.extents[0], (long long)e.extents[1]);
+    if (e.tile[0] == 0) {
+      snprintf(tile, sizeof(tile), "default");
+    } else {
+      snprintf(tile, sizeof(tile), "%lldx%lld", (long long)e.tile[0], (long long)e.tile[1]);
+    }
+    printf("  %-12s %13s %10s %13.4f %13.4f %7.2fx%s\n",
+           e.label.c_str(), extents, tile,
+           1.0e3 * e.default_time, 1.0e3 * e.tuned_time,
+           e.default_time / e.tuned_time, e.from_cache ? " (cached)" : "");
+  }
+}
+
+} // namespace mdrange_autotune
@@ -0,0 +1,146 @@
+// SPDX-FileCopyrightText: 2026 CSC - IT Center for Science Ltd. <www.csc.fi>
+//
+// SPDX-License-Identifier: MIT
+
+// Reproducible floating point sums for Kokkos::parallel_reduce
+//
+// The result of a plain parallel_reduce sum depends on how the work is
+// divided between threads or GPU blocks. Here each term is split into
+// reproducible::fold parts that are rounded to fixed bins (pre-rounding):
+// the parts in the same bin are multiples of the same power of two and
+// their sum fits in the mantissa, so it is exact in any order, and the
+// result is bitwise identical for any backend and number of threads.
+//
+// The bins depend on the largest absolute value and the number of terms,
+// so the sum takes two passes. parallel_sum does both:
+//
+//   double dot = reproducible::parallel_sum("dot", n, KOKKOS_LAMBDA(const int64_t i) {
+//     return x(i) * y(i);
+//   });
+//
+// or with the reducer directly:
+//
+//   const auto bins = reproducible::make_bins(max_abs, n);
+//   reproducible::Value sum;
+//   Kokkos::parallel_reduce(n, KOKKOS_LAMBDA(const int64_t i, reproducible::Value &s) {
+//     s.add(bins, x(i));
+//   }, reproducible::Sum<Kokkos::HostSpace>(sum));
+//   double result = sum.result();
+//
+// The algorithm is the same as in openmp/exercises/reproducible_sum.h.
+// Note! It needs IEEE arithmetic in round-to-nearest mode, do not compile
+// with -ffast-math.
+
+#pragma once
+
+#include <Kokkos_Core.hpp>
+#include <cmath>
+#include <cstdint>
+#include <string>
+
+#if defined(__FAST_MATH__)
+#error "reproducible_sum.hpp does not work with -ffast-math"
+#endif
+
+namespace reproducible {
+
+constexpr int fold = 3;
+
+// Rounding constants of the bins, from the largest to the smallest
+struct Bins {
+  double m[fold];
+};
+
+// Exact partial sums of the bins
+struct Value {
+  double s[fold] = {};
+
+  KOKKOS_INLINE_FUNCTION void add(const Bins &bins, double x)
+  {
+    for (int k = 0; k < fold; k++) {
+      // Round x to a multiple of the unit in the last place of m
+      const double hi = (bins.m[k] + x) - bins.m[k];
+      s[k] += hi;
+      x -= hi;
+    }
+  }
+
+  // Sum of all bins, always added in the same order
+  KOKKOS_INLINE_FUNCTION double result() const
+  {
+    double total = 0.0;
+    for (int k = fold - 1; k >= 0; k--) total += s[k];
+    return total;
+  }
+};
+
+// Bins for summing n values with absolute values at most max_abs
+inline Bins make_bins(const double max_abs, const int64_t n)
+{
+  int log2n = 0;
+  while ((int64_t(1) << log2n) < n) log2n++;
+
+  // All values of the first bin are below 2^e
+  int e;
+  std::frexp(max_abs, &e);
+
+  Bins bins;
+  for (int k = 0; k < fold; k++) {
+    // m + x stays in the binade of m, and the sum of n parts below 2^(e_m + 1)
+    e += log2n + 1;
+    bins.m[k] = std::ldexp(1.5, e);
+    // The remainders are at most half a unit in the last place of m
+    e -= 52;
+  }
+  return bins;
+}
+
+// Custom reducer combining the bins of the partial sums
+template <class Space>
+class Sum {
+public:
+  using reducer = Sum;
+  using value_type = Value;
+  using result_view_type = Kokkos::View<value_type, Space, Kokkos::MemoryUnmanaged>;
+
+  KOKKOS_INLINE_FUNCTION Sum(value_type &value) : value_(&value) {}
+
+  KOKKOS_INLINE_FUNCTION void join(value_type &dest, const value_type &src) const
+  {
+    for (int k = 0; k < fold; k++) dest.s[k] += src.s[k];
+  }
+
+  KOKKOS_INLINE_FUNCTION void init(value_type &value) const
+  {
+    for (int k = 0; k < fold; k++) value.s[k] = 0.0;
+  }
+
+  KOKKOS_INLINE_FUNCTION value_type &reference() const { return *value_.data(); }
+  KOKKOS_INLINE_FUNCTION result_view_type view() const { return value_; }
+  KOKKOS_INLINE_FUNCTION bool references_scalar() const { return true; }
+
+private:
+  result_view_type value_;
+};
+
+// Reproducible sum of f(i) for i = 0, ..., n-1
+template <class F>
+double parallel_sum(const std::string &label, const int64_t n, const F &f)
+{
+  double max_abs = 0.0;
+  Kokkos::parallel_reduce(label + " (max)", Kokkos::RangePolicy<>(0, n),
+    KOKKOS_LAMBDA (const int64_t i, double &m) {
+      m = Kokkos::fmax(m, Kokkos::fabs(f(i)));
+    }, Kokkos::Max<double>(max_abs));
+
+  const Bins bins = make_bins(max_abs, n);
+  Value sum;
+  Kokkos::parallel_reduce(label, Kokkos::RangePolicy<>(0, n),
+    KOKKOS_LAMBDA (const int64_t i, Value &s) {
+      s.add(bins, f(i));
+    }, Sum<Kokkos::HostSpace>(sum));
+
+  return sum.result();
+}
+
+} // namespace reproducible
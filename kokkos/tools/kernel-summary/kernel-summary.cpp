@@ -0,0 +1,228 @@
+// SPDX-FileCopyrightText: 2026 CSC - IT Center for Science Ltd. <www.csc.fi>
+//
+// SPDX-License-Identifier: MIT
+
+// Kokkos Tools connector that summarizes the time spent per kernel label
+//
+// Load it into any Kokkos program with
+//
+//   export KOKKOS_TOOLS_LIBS=/path/to/libkernel-summary.so
+//
+// At Kokkos::finalize a table of the parallel_for/reduce/scan kernels and
+// deep copies is printed, sorted by total time. If KERNEL_SUMMARY_JSON is
+// set, the same data is also written to that file in JSON format.
+//
+// The library only implements the Kokkos Tools C interface, so it does not
+// need Kokkos itself to be compiled.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+struct KokkosPDeviceInfo {
+  size_t deviceID;
+};
+
+struct SpaceHandle {
+  char name[64];
+};
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Summary {
+  uint64_t calls = 0;
+  double total = 0.0;  // seconds
+  double max = 0.0;    // seconds
+  double bytes = 0.0;  // deep copies only
+};
+
+struct Active {
+  std::pair<std::string, std::string> key;  // (type, label)
+  Clock::time_point start;
+  double bytes;
+};
+
+std::mutex lock;
+std::map<std::pair<std::string, std::string>, Summary> summaries;
+std::unordered_map<uint64_t, Active> active;
+uint64_t next_id = 0;
+
+// deep_copy has no id, the calls cannot overlap within a thread
+thread_local std::vector<Active> active_copies;
+
+Clock::time_point t_init;
+
+uint64_t begin(const char *type, const char *name, const double bytes = 0.0)
+{
+  std::lock_guard<std::mutex> guard(lock);
+  const uint64_t id = next_id++;
+  active[id] = {{type, name}, Clock::now(), bytes};
+  return id;
+}
+
+void record(const Active &a)
+{
+  const double t = std::chrono::duration<double>(Clock::now() - a.start).count();
+  Summary &s = summaries[a.key];
+  s.calls++;
+  s.total += t;
+  s.max = std::max(s.max, t);
+  s.bytes += a.bytes;
+}
+
+void end(const uint64_t id)
+{
+  std::lock_guard<std::mutex> guard(lock);
+  auto it = active.find(id);
+  if (it == active.end()) return;
+  record(it->second);
+  active.erase(it);
+}
+
+// Kernel labels may contain any characters
+std::string json_escape(const std::string &s)
+{
+  std::string out;
+  for (char c : s) {
+    if (c == '"' || c == '\\') {
+      out += '\\';
+      out += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char buffer[8];
+      snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+      out += buffer;
+    } else {
+      out += c;
+    }
+  }
+  return out;
+}
+
+void write_json(const char *filename,
+                const std::vector<std::pair<std::pair<std::string, std::string>, Summary>> &rows,
+                const double elapsed)
+{
+  FILE *file = fopen(filename, "w");
+  if (file == NULL) {
+    perror("kernel-summary: Failed to open file");
+    return;
+  }
+  fprintf(file, "{\n  \"elapsed_s\": %.9e,\n  \"kernels\": [", elapsed);
+  for (size_t i = 0; i < rows.size(); i++) {
+    const auto &[key, s] = rows[i];
+    fprintf(file, "%s\n    {\"type\": \"%s\", \"name\": \"%s\", \"calls\": %llu, "
+                  "\"total_s\": %.9e, \"mean_s\": %.9e, \"max_s\": %.9e, \"bytes\": %.0f}",
+            i ? "," : "", key.first.c_str(), json_escape(key.second).c_str(),
+            (unsigned long long)s.calls, s.total, s.total / s.calls, s.max, s.bytes);
+  }
+  fprintf(file, "\n  ]\n}\n");
+  fclose(file);
+  printf("Kernel summary written to %s\n", filename);
+}
+
+} // namespace
+
+extern "C" {
+
+void kokkosp_init_library(const int /* loadSeq */, const uint64_t /* interfaceVer */,
+                          const uint32_t /* devInfoCount */, KokkosPDeviceInfo * /* deviceInfo */)
+{
+  t_init = Clock::now();
+}
+
+void kokkosp_finalize_library()
+{
+  const double elapsed = std::chrono::duration<double>(Clock::now() - t_init).count();
+
+  std::lock_guard<std::mutex> guard(lock);
+  std::vector<std::pair<std::pair<std::string, std::string>, Summary>> rows(
+      summaries.begin(), summaries.end());
+  std::sort(rows.begin(), rows.end(), [](const auto &a, const auto &b) {
+    return a.second.total > b.second.total;
+  });
+
+  double kernel_total = 0.0;
+  for (const auto &row : rows) kernel_total += row.second.total;
+
+  printf("\nKokkos kernel summary (%.3f s since initialize, %.3f s in kernels and copies)\n",
+         elapsed, kernel_total);
+  printf("  %-9s %-32s %8s %12s %12s %12s %7s %10s\n",
+         "type", "name", "calls", "total (ms)", "mean (ms)", "max (ms)", "%", "GB/s");
+  for (const auto &[key, s] : rows) {
+    std::string name = key.second;
+    if (name.size() > 32) name = name.substr(0, 29) + "...";
+    char bandwidth[16] = "";
+    if (s.bytes > 0.0 && s.total > 0.0) {
+      snprintf(bandwidth, sizeof(bandwidth), "%10.2f", 1.0e-9 * s.bytes / s.total);
+    }
+    printf("  %-9s %-32s %8llu %12.4f %12.4f %12.4f %6.1f%% %10s\n",
+           key.first.c_str(), name.c_str(), (unsigned long long)s.calls,
+           1.0e3 * s.total, 1.0e3 * s.total / s.calls, 1.0e3 * s.max,
+           elapsed > 0.0 ? 100.0 * s.total / elapsed : 0.0, bandwidth);
+  }
+
+  const char *filename = std::getenv("KERNEL_SUMMARY_JSON");
+  if (filename != NULL && *filename != '\0') {
+    write_json(filename, rows, elapsed);
+  }
+}
+
+void kokkosp_begin_parallel_for(const char *name, const uint32_t /* devID */, uint64_t *kID)
+{
+  *kID = begin("for", name);
+}
+
+void kokkosp_end_parallel_for(const uint64_t kID)
+{
+  end(kID);
+}
+
+void kokkosp_begin_parallel_reduce(const char *name, const uint32_t /* devID */, uint64_t *kID)
+{
+  *kID = begin("reduce", name);
+}
+
+void kokkosp_end_parallel_reduce(const uint64_t kID)
+{
+  end(kID);
+}
+
+void kokkosp_begin_parallel_scan(const char *name, const uint32_t /* devID */, uint64_t *kID)
+{
+  *kID = begin("scan", name);
+}
+
+void kokkosp_end_parallel_scan(const uint64_t kID)
+{
+  end(kID);
+}
+
+// Deep copies are summarized per pair of memory spaces, e.g. "Host<-Cuda"
+void kokkosp_begin_deep_copy(SpaceHandle dst_handle, const char * /* dst_name */,
+                             const void * /* dst_ptr */, SpaceHandle src_handle,
+                             const char * /* src_name */, const void * /* src_ptr */,
+                             const uint64_t size)
+{
+  const std::string spaces = std::string(dst_handle.name) + "<-" + src_handle.name;
+  active_copies.push_back({{"deep_copy", spaces}, Clock::now(), static_cast<double>(size)});
+}
+
+void kokkosp_end_deep_copy()
+{
+  if (active_copies.empty()) return;
+  std::lock_guard<std::mutex> guard(lock);
+  record(active_copies.back());
+  active_copies.pop_back();
+}
+
+} // extern "C"
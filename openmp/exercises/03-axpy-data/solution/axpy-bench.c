@@ -0,0 +1,63 @@
+// SPDX-FileCopyrightText: 2026 CSC - IT Center for Science Ltd. <www.csc.fi>
+//
+// SPDX-License-Identifier: MIT
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "axpy_helper_functions.h"
+#include "bench.h"
+
+
+int main(int argc, char* argv[]) {
+    // Array size
+    int n = 10240000;
+    if (argc > 1) {
+        n = atoi(argv[1]);
+    }
+    printf("Array size n = %d\n", n);
+
+    double alpha, *x, *y;
+    x = (double*)malloc(n * sizeof(double));
+    y = (double*)malloc(n * sizeof(double));
+
+    char config[256];
+    snprintf(config, sizeof(config), "n=%d", n);
+    bench_t bench;
+    bench_init(&bench, "axpy", config, 1, 20);
+
+    #pragma omp target data map(alloc: x[0:n]) map(from: y[0:n])
+    {
+        // Initialization
+        alpha = 3.0;
+        #pragma omp target teams distribute parallel for
+        for (int i = 0; i < n; i++) {
+            double frac = 1.0 / ((double) (n - 1));
+            x[i] = i * frac;
+            y[i] = i * frac * 100;
+        }
+
+        // Calculate axpy repeatedly with the data staying on the device
+        for (int r = 0; r < bench_total_runs(&bench); r++) {
+            double t0 = bench_time();
+            #pragma omp target teams distribute parallel for
+            for (int i = 0; i < n; i++) {
+                y[i] += alpha * x[i];
+            }
+            bench_add(&bench, bench_time() - t0);
+        }
+    }
+
+    // Print output values
+    printf("Output after %d updates:\n", bench_total_runs(&bench));
+    print_array("y", y, n);
+
+    // Two arrays read, one written
+    bench_stats_t stats = bench_report(&bench, 1.0e-9 * 3.0 * n * sizeof(double), "GB/s");
+    bench_print(&bench, &stats);
+    bench_free(&bench);
+
+    free(y);
+    free(x);
+
+    return 0;
+}
@@ -0,0 +1 @@
+../../../../common/bench.h
\ No newline at end of file
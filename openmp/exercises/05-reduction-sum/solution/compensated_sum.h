@@ -0,0 +1 @@
+../../compensated_sum.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../reproducible_sum.h
\ No newline at end of file
@@ -0,0 +1,165 @@
+// SPDX-FileCopyrightText: 2026 CSC - IT Center for Science Ltd. <www.csc.fi>
+//
+// SPDX-License-Identifier: MIT
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <omp.h>
+#include "bench.h"
+#include "reproducible_sum.h"
+#include "compensated_sum.h"
+
+// Sum of x on the device with reduction(+)
+double sum_plain(const double *x, const int n)
+{
+    double total = 0;
+    #pragma omp target teams distribute parallel for reduction(+:total) map(tofrom: total)
+    for (int i = 0; i < n; i++) {
+        total += x[i];
+    }
+    return total;
+}
+
+// Same sum, bitwise independent of the number of threads and teams
+double sum_reproducible(const double *x, const int n)
+{
+    double max_abs = 0;
+    #pragma omp target teams distribute parallel for reduction(max:max_abs) map(tofrom: max_abs)
+    for (int i = 0; i < n; i++) {
+        max_abs = fmax(max_abs, fabs(x[i]));
+    }
+
+    rsum_bins_t bins = rsum_bins(max_abs, n);
+    rsum_t total = rsum_zero();
+    #pragma omp target teams distribute parallel for reduction(rsum:total) map(tofrom: total)
+    for (int i = 0; i < n; i++) {
+        rsum_add(&total, &bins, x[i]);
+    }
+    return rsum_result(&total);
+}
+
+// Same sum with compensation of the rounding errors
+double sum_compensated(const double *x, const int n)
+{
+    csum_t total = csum_zero();
+    #pragma omp target teams distribute parallel for reduction(csum:total) map(tofrom: total)
+    for (int i = 0; i < n; i++) {
+        csum_add(&total, x[i]);
+    }
+    return csum_result(&total);
+}
+
+// Serial sums on the host in reverse order, i.e. with a different rounding
+double sum_plain_reversed(const double *x, const int n)
+{
+    double total = 0;
+    for (int i = n - 1; i >= 0; i--) {
+        total += x[i];
+    }
+    return total;
+}
+
+double sum_reproducible_reversed(const double *x, const int n)
+{
+    double max_abs = 0;
+    for (int i = n - 1; i >= 0; i--) {
+        max_abs = fmax(max_abs, fabs(x[i]));
+    }
+
+    rsum_bins_t bins = rsum_bins(max_abs, n);
+    rsum_t total = rsum_zero();
+    for (int i = n - 1; i >= 0; i--) {
+        rsum_add(&total, &bins, x[i]);
+    }
+    return rsum_result(&total);
+}
+
+double sum_compensated_reversed(const double *x, const int n)
+{
+    csum_t total = csum_zero();
+    for (int i = n - 1; i >= 0; i--) {
+        csum_add(&total, x[i]);
+    }
+    return csum_result(&total);
+}
+
+// Accurate reference: compensated sum in extended precision
+double sum_reference(const double *x, const int n)
+{
+    long double total = 0, c = 0;
+    for (int i = 0; i < n; i++) {
+        long double t = total + x[i];
+        if (fabsl(total) >= fabs(x[i])) {
+            c += (total - t) + x[i];
+        } else {
+            c += (x[i] - t) + total;
+        }
+        total = t;
+    }
+    return (double)(total + c);
+}
+
+typedef double (*sum_func_t)(const double *, const int);
+
+// Time the device sum and compare with the reference and the reversed host sum
+void run(const char *mode, sum_func_t sum, sum_func_t sum_reversed,
+         const double *x, const int n, const double reference, double *plain_time)
+{
+    char config[256];
+    snprintf(config, sizeof(config), "%s n=%d", mode, n);
+    bench_t bench;
+    bench_init(&bench, "reduction-sum", config, 1, 20);
+
+    double total = 0;
+    for (int r = 0; r < bench_total_runs(&bench); r++) {
+        double t0 = bench_time();
+        total = sum(x, n);
+        bench_add(&bench, bench_time() - t0);
+    }
+
+    const double reversed = sum_reversed(x, n);
+
+    bench_stats_t stats = bench_report(&bench, 1.0e-9 * n * sizeof(double), "GB/s");
+    bench_free(&bench);
+
+    if (*plain_time == 0) {
+        *plain_time = stats.median;
+    }
+    printf("  %-13s %24.17e %10.2e %10s %10.2f %9.2f\n", mode, total, fabs(total - reference),
+           memcmp(&total, &reversed, sizeof(double)) == 0 ? "yes" : "no",
+           stats.throughput, stats.median / *plain_time);
+}
+
+int main(int argc, char* argv[])
+{
+    // Array size
+    int n = 100000000;
+    if (argc > 1) {
+        n = atoi(argv[1]);
+    }
+    printf("Array size: %d\n", n);
+
+    double *x = (double*)malloc(n * sizeof(double));
+    for (int i = 0; i < n; i++) {
+        x[i] = sin((double)i);
+    }
+
+    const double reference = sum_reference(x, n);
+    printf("Reference sum: %.17e\n", reference);
+    printf("  %-13s %24s %10s %10s %10s %9s\n", "mode", "sum (device)",
+           "error", "=reversed", "GB/s", "time");
+
+    double plain_time = 0;
+    #pragma omp target data map(to: x[0:n])
+    {
+        run("plain", sum_plain, sum_plain_reversed, x, n, reference, &plain_time);
+        run("compensated", sum_compensated, sum_compensated_reversed, x, n, reference, &plain_time);
+        run("reproducible", sum_reproducible, sum_reproducible_reversed, x, n, reference, &plain_time);
+    }
+
+    free(x);
+
+    return 0;
+}
@@ -0,0 +1 @@
+../heat-post.cpp
\ No newline at end of file
@@ -0,0 +1,273 @@
+/*
+ * SPDX-FileCopyrightText: 2026 CSC - IT Center for Science Ltd. <www.csc.fi>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// Heat equation with the average temperature monitored over many regions:
+// the four quadrants, a grid of ntile x ntile tiles, two masks (a disc and
+// a ring around it), and a grid of ncell x ncell masks covering the rest of
+// the box. The time of the diagnostics is compared with one reduction
+// kernel per region.
+//
+// Usage: ./heat-regions [n] [niter] [ntile] [ncell]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <omp.h>
+#include "heat_helper_functions.h"
+#include "heat_regions.h"
+
+
+// Sums over all regions with one reduction kernel per region
+void naive_sums(const heat_regions_t *r, const double *u, double *sum)
+{
+    const int nx = r->nx, ny = r->ny;
+    for (int k = 0; k < r->nrect; k++) {
+        const int i0 = r->rect[4 * k], i1 = r->rect[4 * k + 1];
+        const int j0 = r->rect[4 * k + 2], j1 = r->rect[4 * k + 3];
+        double s = 0.0;
+        #pragma omp target map(tofrom: s)
+        #pragma omp teams distribute parallel for collapse(2) reduction(+:s)
+        for (int i = i0; i < i1; i++) {
+            for (int j = j0; j < j1; j++) {
+                s += u[i * nx + j];
+            }
+        }
+        sum[k] = s;
+    }
+
+    const int *label = r->label;
+    for (int l = 0; l < r->nmask; l++) {
+        double s = 0.0;
+        #pragma omp target map(tofrom: s)
+        #pragma omp teams distribute parallel for collapse(2) reduction(+:s)
+        for (int i = 0; i < ny; i++) {
+            for (int j = 0; j < nx; j++) {
+                if (label[i * nx + j] == l) {
+                    s += u[i * nx + j];
+                }
+            }
+        }
+        sum[r->nrect + l] = s;
+    }
+}
+
+
+int run(const int n, const int niter, const int ntile, const int ncell)
+{
+    // Grid size
+    const int nx = n, ny = n;
+    const int n2 = nx * ny;
+
+    // Box size
+    const double Lx = 8.0;
+    const double Ly = 8.0;
+
+    // Diffusivity
+    const double alpha = 0.5;
+
+    // Grid spacing
+    const double dx = Lx / (nx - 1);
+    const double dy = Ly / (ny - 1);
+    const double dx2 = dx * dx;
+    const double dy2 = dy * dy;
+
+    // Largest stable time step
+    const double dt = dx2 * dy2 / (2.0 * alpha * (dx2 + dy2));
+
+    // Print inputs
+    printf("Inputs: n = %d, niter = %d, ntile = %d, ncell = %d\n", n, niter, ntile, ncell);
+
+    const double rx = alpha * dt / dx2;
+    const double ry = alpha * dt / dy2;
+
+    double *u, *unew;
+    u = (double*)malloc(n2 * sizeof(double));
+    unew = (double*)malloc(n2 * sizeof(double));
+
+    // Initialize arrays
+    create_input(u, nx, ny, Lx, Ly);
+    memset(unew, 0, n2 * sizeof(double));
+
+    // Monitoring regions: the quadrants first, so that the printed averages
+    // are those of the quadrants in heat.c
+    heat_regions_t regions;
+    heat_regions_init(&regions, nx, ny);
+    const int nx2 = nx / 2, ny2 = ny / 2;
+    heat_regions_add_rect(&regions, "quadrant 0", 0, ny2, 0, nx2);
+    heat_regions_add_rect(&regions, "quadrant 1", 0, ny2, nx2, nx);
+    heat_regions_add_rect(&regions, "quadrant 2", ny2, ny, 0, nx2);
+    heat_regions_add_rect(&regions, "quadrant 3", ny2, ny, nx2, nx);
+    for (int ti = 0; ti < ntile; ti++) {
+        for (int tj = 0; tj < ntile; tj++) {
+            char name[HEAT_REGION_NAME_LEN];
+            snprintf(name, sizeof(name), "tile %d,%d", ti, tj);
+            heat_regions_add_rect(&regions, name, ti * ny / ntile, (ti + 1) * ny / ntile,
+                                  tj * nx / ntile, (tj + 1) * nx / ntile);
+        }
+    }
+
+    // The field is antisymmetric about the centre of the box, so the disc and
+    // the ring are placed off-centre to have nonzero averages
+    unsigned char *disc = malloc(n2), *ring = malloc(n2);
+    for (int i = 0; i < ny; i++) {
+        for (int j = 0; j < nx; j++) {
+            double x = j * dx - 0.35 * Lx;
+            double y = i * dy - 0.6 * Ly;
+            double r = sqrt(x * x + y * y);
+            disc[i * nx + j] = r < 1.0;
+            ring[i * nx + j] = r >= 1.0 && r < 2.0;
+        }
+    }
+    const int disc_id = heat_regions_add_mask(&regions, "disc r < 1", disc);
+    const int ring_id = heat_regions_add_mask(&regions, "ring 1 <= r < 2", ring);
+
+    // Cells of the box outside the disc and the ring
+    unsigned char *cell = malloc(n2);
+    int failed = disc_id < 0 || ring_id < 0;
+    for (int ci = 0; ci < ncell && !failed; ci++) {
+        for (int cj = 0; cj < ncell && !failed; cj++) {
+            for (int i = 0; i < ny; i++) {
+                for (int j = 0; j < nx; j++) {
+                    cell[i * nx + j] = i * ncell / ny == ci && j * ncell / nx == cj
+                                    && !disc[i * nx + j] && !ring[i * nx + j];
+                }
+            }
+            char name[HEAT_REGION_NAME_LEN];
+            snprintf(name, sizeof(name), "cell %d,%d", ci, cj);
+            failed = heat_regions_add_mask(&regions, name, cell) < 0;
+        }
+    }
+    free(cell);
+    free(disc);
+    free(ring);
+    if (failed) {
+        heat_regions_free(&regions);
+        free(unew);
+        free(u);
+        return 1;
+    }
+
+    const int nregion = regions.nregion;
+    printf("Monitoring %d regions (%d rectangles, %d masks)\n",
+           nregion, regions.nrect, regions.nmask);
+
+    double *naive = malloc(nregion * sizeof(double));
+    double t_regions = 0.0, t_naive = 0.0, max_diff = 0.0;
+    int ndiag = 0;
+
+    // Propagate in time
+    double t0 = omp_get_wtime();
+
+#pragma omp target data map(tofrom: u[0:nx*ny]) map(to: unew[0:nx*ny])
+{
+    heat_regions_map(&regions);
+
+    for (int it = 1; it < niter + 1; it++) {
+
+        // Stencil update
+        #pragma omp target
+        #pragma omp teams distribute parallel for collapse(2)
+        for (int i = 1; i < ny - 1; i++) {
+            for (int j = 1; j < nx - 1; j++) {
+                int ij = i * nx + j;
+                int ip = (i + 1) * nx + j;
+                int im = (i - 1) * nx + j;
+                int jp = i * nx + j + 1;
+                int jm = i * nx + j - 1;
+                unew[ij] = u[ij] + rx * (u[jp] - 2 * u[ij] + u[jm]) + ry * (u[ip] - 2 * u[ij] + u[im]);
+            }
+        }
+
+        // Swap the arrays
+        double *tmp = u;
+        u = unew;
+        unew = tmp;
+
+        // Calculate averages per region
+        if (it % 100 == 0) {
+            double t1 = omp_get_wtime();
+            heat_regions_compute(&regions, u);
+            double t2 = omp_get_wtime();
+            naive_sums(&regions, u, naive);
+            double t3 = omp_get_wtime();
+
+            t_regions += t2 - t1;
+            t_naive += t3 - t2;
+            ndiag++;
+            for (int k = 0; k < nregion; k++) {
+                max_diff = fmax(max_diff, fabs(naive[k] / regions.count[k]
+                                               - heat_regions_average(&regions, k)));
+            }
+
+            heat_regions_print(&regions, it, 4);
+        }
+
+    }
+
+} // implicit wait at the end of the data clause
+
+    double t1 = omp_get_wtime();
+
+    printf("Final averages: %s %+.4f, %s %+.4f\n",
+           regions.name[disc_id], heat_regions_average(&regions, disc_id),
+           regions.name[ring_id], heat_regions_average(&regions, ring_id));
+    printf("Time spent: %.3f s\n", t1 - t0);
+    write_array("u_final.bin", u, nx, ny, Lx, Ly);
+    if (ndiag > 0) {
+        printf("Diagnostics per step: %.3f ms with the region kernels, "
+               "%.3f ms with one kernel per region (max difference %.2e)\n",
+               1.0e3 * t_regions / ndiag, 1.0e3 * t_naive / ndiag, max_diff);
+    }
+
+    heat_regions_free(&regions);
+    free(naive);
+    free(unew);
+    free(u);
+    return 0;
+}
+
+
+int main(int argc, char *argv[])
+{
+    // Default values
+    int n = 1024;
+    int niter = 500;
+    int ntile = 16;
+    int ncell = 16;
+
+    if (argc > 1) {
+        n = atoi(argv[1]);
+        if (n < 1) {
+            printf("Size needs to be greater than zero.\n");
+            return 1;
+        }
+    }
+    if (argc > 2) {
+        niter = atoi(argv[2]);
+        if (niter < 1) {
+            printf("Number of iterations need to be greater than zero.\n");
+            return 1;
+        }
+    }
+    if (argc > 3) {
+        ntile = atoi(argv[3]);
+        if (ntile < 0 || ntile > n) {
+            printf("Number of tiles per side needs to be between 0 and the size.\n");
+            return 1;
+        }
+    }
+
+    if (argc > 4) {
+        ncell = atoi(argv[4]);
+        if (ncell < 0 || ncell > n) {
+            printf("Number of mask cells per side needs to be between 0 and the size.\n");
+            return 1;
+        }
+    }
+
+    return run(n, niter, ntile, ncell);
+}
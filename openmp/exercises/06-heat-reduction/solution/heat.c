@@ -9,6 +9,8 @@
 #include <string.h>
 #include <omp.h>
 #include "heat_helper_functions.h"
+#include "heat_stats.h"
+#include "perf_regions.h"
 
 
 void run(const int n, const int niter)
@@ -62,6 +64,7 @@ void run(const int n, const int niter)
     for (int it = 1; it < niter + 1; it++) {
 
         // Stencil update
+        PERF_REGION_BEGIN("stencil");
         #pragma omp target
         #pragma omp teams distribute parallel for collapse(2)
         for (int i = 1; i < ny - 1; i++) {
@@ -74,55 +77,28 @@ void run(const int n, const int niter)
                 unew[ij] = u[ij] + rx * (u[jp] - 2 * u[ij] + u[jm]) + ry * (u[ip] - 2 * u[ij] + u[im]);
             }
         }
+        PERF_REGION_END("stencil", (nx - 2.0) * (ny - 2.0));
 
         // Swap the arrays
         double *tmp = u;
         u = unew;
         unew = tmp;
 
-        // Calculate average per quadrant
+        // Calculate statistics per quadrant
         if (it % 100 == 0) {
-            const int nx2 = nx / 2;
-            const int ny2 = ny / 2;
-            double avg[4] = {0.0, 0.0, 0.0, 0.0};
-
-            #pragma omp target map(tofrom: avg[0])
-            #pragma omp teams distribute parallel for collapse(2) reduction(+:avg[0])
-            for (int i = 0; i < ny2; i++) {
-                for (int j = 0; j < nx2; j++) {
-                    avg[0] += u[i * nx + j];
+            heat_stats_t stats = heat_stats_init();
+
+            PERF_REGION_BEGIN("quadrant reductions");
+            #pragma omp target map(tofrom: stats)
+            #pragma omp teams distribute parallel for collapse(2) reduction(heat_stats:stats)
+            for (int i = 0; i < ny; i++) {
+                for (int j = 0; j < nx; j++) {
+                    heat_stats_add(&stats, heat_quadrant(i, j, nx, ny), u[i * nx + j]);
                 }
             }
+            PERF_REGION_END("quadrant reductions", (double)nx * ny);
 
-            #pragma omp target map(tofrom: avg[1])
-            #pragma omp teams distribute parallel for collapse(2) reduction(+:avg[1])
-            for (int i = 0; i < ny2; i++) {
-                for (int j = nx2; j < nx; j++) {
-                    avg[1] += u[i * nx + j];
-                }
-            }
-
-            #pragma omp target map(tofrom: avg[2])
-            #pragma omp teams distribute parallel for collapse(2) reduction(+:avg[2])
-            for (int i = ny2; i < ny; i++) {
-                for (int j = 0; j < nx2; j++) {
-                    avg[2] += u[i * nx + j];
-                }
-            }
-
-            #pragma omp target map(tofrom: avg[3])
-            #pragma omp teams distribute parallel for collapse(2) reduction(+:avg[3])
-            for (int i = ny2; i < ny; i++) {
-                for (int j = nx2; j < nx; j++) {
-                    avg[3] += u[i * nx + j];
-                }
-            }
-
-            printf("%06d:  %+9.4f  %+9.4f  %+9.4f  %+9.4f\n", it,
-                   avg[0] / (ny2 * nx2),
-                   avg[1] / (ny2 * (nx - nx2)),
-                   avg[2] / ((ny - ny2) * nx2),
-                   avg[3] / ((ny - ny2) * (nx - nx2)));
+            heat_stats_print(it, &stats, dx, dy);
         }
 
     }
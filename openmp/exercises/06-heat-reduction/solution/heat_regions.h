@@ -0,0 +1 @@
+../../heat_regions.h
\ No newline at end of file
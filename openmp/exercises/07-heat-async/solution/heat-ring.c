@@ -0,0 +1,214 @@
+/*
+ * SPDX-FileCopyrightText: 2026 CSC - IT Center for Science Ltd. <www.csc.fi>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// Heat equation with frequent diagnostics kept on the device
+//
+// Instead of copying the statistics of every diagnostic step to the host
+// and printing them before continuing, the reduction kernel writes them
+// into a ring buffer on the device. Whenever half of the ring is full, it
+// is copied to the host with an asynchronous target update and printed by
+// a host task, while the GPU continues with the other half.
+//
+// Usage: ./heat-ring [n] [niter] [diagnostics interval] [sync]
+// With "sync" as the last argument the statistics are copied and printed
+// at every diagnostic step as in heat.c, for comparison.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <omp.h>
+#include "heat_helper_functions.h"
+#include "heat_stats.h"
+
+// Ring buffer length, drained in two halves
+#define NRING 64
+#define NBATCH (NRING / 2)
+
+
+void run(const int n, const int niter, const int every, const int sync)
+{
+    // Grid size
+    const int nx = n, ny = n;
+    const int n2 = nx * ny;
+
+    // Box size
+    const double Lx = 8.0;
+    const double Ly = 8.0;
+
+    // Diffusivity
+    const double alpha = 0.5;
+
+    // Grid spacing
+    const double dx = Lx / (nx - 1);
+    const double dy = Ly / (ny - 1);
+    const double dx2 = dx * dx;
+    const double dy2 = dy * dy;
+
+    // Largest stable time step
+    const double dt = dx2 * dy2 / (2.0 * alpha * (dx2 + dy2));
+
+    // Print inputs
+    printf("Inputs: n = %d, niter = %d, diagnostics every %d steps (%s)\n",
+           n, niter, every, sync ? "synchronous" : "ring buffer");
+
+    const double rx = alpha * dt / dx2;
+    const double ry = alpha * dt / dy2;
+
+    double *u, *unew;
+    u = (double*)malloc(n2 * sizeof(double));
+    unew = (double*)malloc(n2 * sizeof(double));
+
+    // Initialize arrays
+    create_input(u, nx, ny, Lx, Ly);
+    memset(unew, 0, n2 * sizeof(double));
+
+    // Statistics of the diagnostic steps
+    heat_stats_t ring[NRING];
+    int ndiag = 0;
+
+    // Propagate in time
+    double t0 = omp_get_wtime();
+
+#pragma omp parallel num_threads(2)
+#pragma omp single
+{
+
+#pragma omp target data map(tofrom: u[0:nx*ny]) map(to: unew[0:nx*ny]) map(alloc: ring[0:NRING])
+{
+
+    for (int it = 1; it < niter + 1; it++) {
+
+        // Stencil update
+        #pragma omp target nowait depend(in: u[0:nx*ny]) depend(out: unew[0:nx*ny])
+        #pragma omp teams distribute parallel for collapse(2)
+        for (int i = 1; i < ny - 1; i++) {
+            for (int j = 1; j < nx - 1; j++) {
+                int ij = i * nx + j;
+                int ip = (i + 1) * nx + j;
+                int im = (i - 1) * nx + j;
+                int jp = i * nx + j + 1;
+                int jm = i * nx + j - 1;
+                unew[ij] = u[ij] + rx * (u[jp] - 2 * u[ij] + u[jm]) + ry * (u[ip] - 2 * u[ij] + u[im]);
+            }
+        }
+
+        // Swap the arrays
+        double *tmp = u;
+        u = unew;
+        unew = tmp;
+
+        if (it % every != 0) {
+            continue;
+        }
+
+        if (sync) {
+            // Copy back and print before continuing
+            heat_stats_t stats = heat_stats_init();
+            #pragma omp target map(tofrom: stats) depend(in: u[0:nx*ny])
+            #pragma omp teams distribute parallel for collapse(2) reduction(heat_stats:stats)
+            for (int i = 0; i < ny; i++) {
+                for (int j = 0; j < nx; j++) {
+                    heat_stats_add(&stats, heat_quadrant(i, j, nx, ny), u[i * nx + j]);
+                }
+            }
+            heat_stats_print(it, &stats, dx, dy);
+            continue;
+        }
+
+        const int slot = ndiag % NRING;
+        const int first = slot - slot % NBATCH;
+        ndiag++;
+
+        // Reduce into the ring slot on the device. The first element of each
+        // half serves as the dependency object of all operations on that half
+        // (depend clauses may not use overlapping array sections), so a slot
+        // is reused only after its previous contents have been printed.
+        #pragma omp target nowait depend(inout: ring[first])
+        {
+            ring[slot] = heat_stats_init();
+        }
+
+        #pragma omp target teams distribute parallel for collapse(2) nowait \
+            reduction(heat_stats:ring[slot:1]) depend(in: u[0:nx*ny]) depend(inout: ring[first])
+        for (int i = 0; i < ny; i++) {
+            for (int j = 0; j < nx; j++) {
+                heat_stats_add(&ring[slot], heat_quadrant(i, j, nx, ny), u[i * nx + j]);
+            }
+        }
+
+        // Drain a full half to the host and print it in a separate host thread
+        if (slot % NBATCH == NBATCH - 1 || it + every > niter) {
+            const int count = slot - first + 1;
+            const int first_it = it - (count - 1) * every;
+
+            #pragma omp target update from(ring[first:count]) nowait depend(inout: ring[first])
+
+            #pragma omp task firstprivate(first, count, first_it) depend(inout: ring[first])
+            {
+                for (int k = 0; k < count; k++) {
+                    heat_stats_print(first_it + k * every, &ring[first + k], dx, dy);
+                }
+            }
+        }
+
+    }
+
+#pragma omp taskwait
+
+} // implicit wait at the end of the data clause
+
+} // end of host threads
+
+    double t1 = omp_get_wtime();
+
+    // Write final result
+    int i = (ny - 1) / 2, j = (nx - 1) / 2;
+    printf("u[%d,%d] = %f\n", i, j, u[i * nx + j]);
+    printf("Time spent: %.3f s (%.3f ms per step)\n", t1 - t0, 1.0e3 * (t1 - t0) / niter);
+    write_array("u_final.bin", u, nx, ny, Lx, Ly);
+
+    free(unew);
+    free(u);
+}
+
+
+int main(int argc, char *argv[])
+{
+    // Default values
+    int n = 1024;
+    int niter = 500;
+    int every = 1;
+    int sync = 0;
+
+    if (argc > 1) {
+        n = atoi(argv[1]);
+        if (n < 1) {
+            printf("Size needs to be greater than zero.\n");
+            return 1;
+        }
+    }
+    if (argc > 2) {
+        niter = atoi(argv[2]);
+        if (niter < 1) {
+            printf("Number of iterations need to be greater than zero.\n");
+            return 1;
+        }
+    }
+    if (argc > 3) {
+        every = atoi(argv[3]);
+        if (every < 1) {
+            printf("Diagnostics interval needs to be greater than zero.\n");
+            return 1;
+        }
+    }
+    if (argc > 4) {
+        sync = strcmp(argv[4], "sync") == 0;
+    }
+
+    run(n, niter, every, sync);
+
+    return 0;
+}
@@ -0,0 +1 @@
+../heat_stats.h
\ No newline at end of file
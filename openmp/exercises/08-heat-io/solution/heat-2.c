@@ -9,6 +9,10 @@
 #include <string.h>
 #include <omp.h>
 #include "heat_helper_functions.h"
+#include "heat_stats.h"
+#ifdef SNAPSHOT_BAND_ROWS
+#include "snapshot_writer.h"
+#endif
 
 
 void run(const int n, const int niter)
@@ -53,6 +57,12 @@ void run(const int n, const int niter)
     // Write initial arrays
     write_array("u_initial.bin", u, nx, ny, Lx, Ly);
 
+#ifdef SNAPSHOT_BAND_ROWS
+    // Write the snapshots in bands of rows (see snapshot_writer.h)
+    snapshot_writer_t writer;
+    snapshot_writer_init(&writer, SNAPSHOT_BAND_ROWS);
+#endif
+
     // Propagate in time
     double t0 = omp_get_wtime();
 
@@ -61,7 +71,7 @@ void run(const int n, const int niter)
 
     // Due to a bug in NVHPC compiler, we need to declare the reduction variables
     // outside the host-threaded scope
-    double avg[4];
+    heat_stats_t stats;
 
 #pragma omp parallel num_threads(2)
 #pragma omp single
@@ -73,6 +83,7 @@ void run(const int n, const int niter)
     for (int it = 1; it < niter + 1; it++) {
 
         // Stencil update
+        TRACE_PUSH("stencil enqueue");
         #pragma omp target nowait depend(in: u[0:nx*ny]) depend(out: unew[0:nx*ny])
         #pragma omp teams distribute parallel for collapse(2)
         for (int i = 1; i < ny - 1; i++) {
@@ -85,68 +96,49 @@ void run(const int n, const int niter)
                 unew[ij] = u[ij] + rx * (u[jp] - 2 * u[ij] + u[jm]) + ry * (u[ip] - 2 * u[ij] + u[im]);
             }
         }
+        TRACE_POP();
 
         // Swap the arrays
         double *tmp = u;
         u = unew;
         unew = tmp;
 
-        // Calculate average per quadrant
+        // Calculate statistics per quadrant
         if (it % 100 == 0) {
-            const int nx2 = nx / 2;
-            const int ny2 = ny / 2;
-
-            #pragma omp task depend(out: avg[:4])
+            TRACE_PUSH("reduction enqueue");
+            #pragma omp task depend(out: stats)
             {
-                avg[0] = 0.0; avg[1] = 0.0; avg[2] = 0.0; avg[3] = 0.0;
-            }
-
-            #pragma omp target nowait map(tofrom: avg[0]) depend(in: u[0:nx*ny]) depend(inout:avg[0])
-            #pragma omp teams distribute parallel for collapse(2) reduction(+:avg[0])
-            for (int i = 0; i < ny2; i++) {
-                for (int j = 0; j < nx2; j++) {
-                    avg[0] += u[i * nx + j];
-                }
+                stats = heat_stats_init();
             }
 
-            #pragma omp target nowait map(tofrom: avg[1]) depend(in: u[0:nx*ny]) depend(inout:avg[1])
-            #pragma omp teams distribute parallel for collapse(2) reduction(+:avg[1])
-            for (int i = 0; i < ny2; i++) {
-                for (int j = nx2; j < nx; j++) {
-                    avg[1] += u[i * nx + j];
+            #pragma omp target nowait map(tofrom: stats) depend(in: u[0:nx*ny]) depend(inout: stats)
+            #pragma omp teams distribute parallel for collapse(2) reduction(heat_stats:stats)
+            for (int i = 0; i < ny; i++) {
+                for (int j = 0; j < nx; j++) {
+                    heat_stats_add(&stats, heat_quadrant(i, j, nx, ny), u[i * nx + j]);
                 }
             }
 
-            #pragma omp target nowait map(tofrom: avg[2]) depend(in: u[0:nx*ny]) depend(inout:avg[2])
-            #pragma omp teams distribute parallel for collapse(2) reduction(+:avg[2])
-            for (int i = ny2; i < ny; i++) {
-                for (int j = 0; j < nx2; j++) {
-                    avg[2] += u[i * nx + j];
-                }
-            }
-
-            #pragma omp target nowait map(tofrom: avg[3]) depend(in: u[0:nx*ny]) depend(inout:avg[3])
-            #pragma omp teams distribute parallel for collapse(2) reduction(+:avg[3])
-            for (int i = ny2; i < ny; i++) {
-                for (int j = nx2; j < nx; j++) {
-                    avg[3] += u[i * nx + j];
-                }
-            }
+            TRACE_POP();
 
             // Print in a separate host thread
-            #pragma omp task firstprivate(it) depend(in: avg[:4])
+            #pragma omp task firstprivate(it) depend(in: stats)
             {
-                printf("%06d:  %+9.4f  %+9.4f  %+9.4f  %+9.4f\n", it,
-                       avg[0] / (ny2 * nx2),
-                       avg[1] / (ny2 * (nx - nx2)),
-                       avg[2] / ((ny - ny2) * nx2),
-                       avg[3] / ((ny - ny2) * (nx - nx2)));
+                heat_stats_print(it, &stats, dx, dy);
             }
         }
 
         // Write data
         if (it % 1000 == 0) {
+#ifdef SNAPSHOT_BAND_ROWS
+            // The bands are copied and written in the other host thread
+            char filename[20];
+            sprintf(filename, "u_%06d.bin", it);
+            snapshot_write_tasks(&writer, filename, u, nx, ny, Lx, Ly);
+#else
+            TRACE_PUSH("target update");
             #pragma omp target update from(u[0:nx*ny]) depend(in: u[0:nx*ny]) depend(inout:write_flag)
+            TRACE_POP();
 
             // Write in a separate host thread
             #pragma omp task firstprivate(it, u) depend(inout:write_flag)
@@ -155,6 +147,7 @@ void run(const int n, const int niter)
                 sprintf(filename, "u_%06d.bin", it);
                 write_array(filename, u, nx, ny, Lx, Ly);
             }
+#endif
         }
 
     }
@@ -173,6 +166,10 @@ void run(const int n, const int niter)
     printf("Time spent: %.3f s\n", t1 - t0);
     write_array("u_final.bin", u, nx, ny, Lx, Ly);
 
+#ifdef SNAPSHOT_BAND_ROWS
+    heat_staging_print(&writer.staging);
+    snapshot_writer_free(&writer);
+#endif
     free(unew);
     free(u);
 }
@@ -0,0 +1,213 @@
+/*
+ * SPDX-FileCopyrightText: 2026 CSC - IT Center for Science Ltd. <www.csc.fi>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// As heat-2.c, but the snapshots are copied to a snapshot buffer on the device
+// and from there in chunks through pinned staging buffers (see heat_staging.h),
+// so that the copies overlap with writing the file and the kernels wait only
+// for the device-to-device copy.
+//
+// Usage: ./heat-3 [n] [niter] [nrep] [chunk size in MB]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <omp.h>
+#include "heat_helper_functions.h"
+#include "heat_stats.h"
+#include "heat_staging.h"
+
+
+void run(const int n, const int niter, const double chunk_mb)
+{
+    // Grid size
+    const int nx = n, ny = n;
+    const int n2 = nx * ny;
+
+    // Box size
+    const double Lx = 8.0;
+    const double Ly = 8.0;
+
+    // Diffusivity
+    const double alpha = 0.5;
+
+    // Grid spacing
+    const double dx = Lx / (nx - 1);
+    const double dy = Ly / (ny - 1);
+    const double dx2 = dx * dx;
+    const double dy2 = dy * dy;
+
+    // Largest stable time step
+    const double dt = dx2 * dy2 / (2.0 * alpha * (dx2 + dy2));
+
+    // Print inputs
+    printf("Inputs: n = %d, niter = %d\n", n, niter);
+    printf("Diffusivity: %.2f\n", alpha);
+    printf("Box: %.2f x %.2f discretized with grid spacing %.2e x %.2e\n", Lx, Ly, dx, dy);
+    printf("Time propagation until %.2e with time step %.2e\n", dt * niter, dt);
+
+    const double rx = alpha * dt / dx2;
+    const double ry = alpha * dt / dy2;
+
+    double *u, *unew;
+    u = (double*)malloc(n2 * sizeof(double));
+    unew = (double*)malloc(n2 * sizeof(double));
+
+    // Initialize arrays
+    create_input(u, nx, ny, Lx, Ly);
+    memset(unew, 0, n2 * sizeof(double));
+
+    // Write initial arrays
+    write_array("u_initial.bin", u, nx, ny, Lx, Ly);
+
+    // Staging buffers for the snapshots
+    heat_staging_t staging;
+    heat_staging_init(&staging, (size_t)(chunk_mb * 1.0e6));
+
+    // Propagate in time
+    double t0 = omp_get_wtime();
+
+    // Due to a bug in NVHPC compiler, we need to declare the reduction variables
+    // outside the host-threaded scope
+    heat_stats_t stats;
+
+// One thread launches the kernels and the others run the copies and writing
+#pragma omp parallel num_threads(3)
+#pragma omp single
+{
+
+#pragma omp target data map(tofrom: u[0:nx*ny]) map(to: unew[0:nx*ny])
+{
+
+    for (int it = 1; it < niter + 1; it++) {
+
+        // Stencil update
+        TRACE_PUSH("stencil enqueue");
+        #pragma omp target nowait depend(in: u[0:nx*ny]) depend(out: unew[0:nx*ny])
+        #pragma omp teams distribute parallel for collapse(2)
+        for (int i = 1; i < ny - 1; i++) {
+            for (int j = 1; j < nx - 1; j++) {
+                int ij = i * nx + j;
+                int ip = (i + 1) * nx + j;
+                int im = (i - 1) * nx + j;
+                int jp = i * nx + j + 1;
+                int jm = i * nx + j - 1;
+                unew[ij] = u[ij] + rx * (u[jp] - 2 * u[ij] + u[jm]) + ry * (u[ip] - 2 * u[ij] + u[im]);
+            }
+        }
+        TRACE_POP();
+
+        // Swap the arrays
+        double *tmp = u;
+        u = unew;
+        unew = tmp;
+
+        // Calculate statistics per quadrant
+        if (it % 100 == 0) {
+            TRACE_PUSH("reduction enqueue");
+            #pragma omp task depend(out: stats)
+            {
+                stats = heat_stats_init();
+            }
+
+            #pragma omp target nowait map(tofrom: stats) depend(in: u[0:nx*ny]) depend(inout: stats)
+            #pragma omp teams distribute parallel for collapse(2) reduction(heat_stats:stats)
+            for (int i = 0; i < ny; i++) {
+                for (int j = 0; j < nx; j++) {
+                    heat_stats_add(&stats, heat_quadrant(i, j, nx, ny), u[i * nx + j]);
+                }
+            }
+
+            TRACE_POP();
+
+            // Print in a separate host thread
+            #pragma omp task firstprivate(it) depend(in: stats)
+            {
+                heat_stats_print(it, &stats, dx, dy);
+            }
+        }
+
+        // Write data through the staging buffers
+        if (it % 1000 == 0) {
+            TRACE_PUSH("staging");
+            char filename[20];
+            sprintf(filename, "u_%06d.bin", it);
+            double *u_host = u;
+            #pragma omp target data use_device_ptr(u)
+            {
+                heat_staging_write(&staging, filename, u_host, u, nx, ny, Lx, Ly);
+            }
+            TRACE_POP();
+        }
+
+    }
+
+#pragma omp taskwait
+
+} // implicit wait at the end of the data clause
+
+} // end of host threads
+
+    double t1 = omp_get_wtime();
+
+    // Write final result
+    int i = (ny - 1) / 2, j = (nx - 1) / 2;
+    printf("u[%d,%d] = %f\n", i, j, u[i * nx + j]);
+    printf("Time spent: %.3f s\n", t1 - t0);
+    heat_staging_print(&staging);
+    heat_staging_free(&staging);
+    write_array("u_final.bin", u, nx, ny, Lx, Ly);
+
+    free(unew);
+    free(u);
+}
+
+
+int main(int argc, char *argv[])
+{
+    // Default values
+    int n = 1024;
+    int niter = 500;
+    int nrep = 3;
+    double chunk_mb = 4.0;
+
+    if (argc > 1) {
+        n = atoi(argv[1]);
+        if (n < 1) {
+            printf("Size needs to be greater than zero.\n");
+            return 1;
+        }
+    }
+    if (argc > 2) {
+        niter = atoi(argv[2]);
+        if (niter < 1) {
+            printf("Number of iterations need to be greater than zero.\n");
+            return 1;
+        }
+    }
+    if (argc > 3) {
+        nrep = atoi(argv[3]);
+        if (nrep < 1) {
+            printf("Number of repetitions need to be greater than zero.\n");
+            return 1;
+        }
+    }
+
+    if (argc > 4) {
+        chunk_mb = atof(argv[4]);
+        if (chunk_mb <= 0.0) {
+            printf("Chunk size needs to be greater than zero.\n");
+            return 1;
+        }
+    }
+
+    for (int i = 0; i < nrep; i++) {
+        printf("RUN %d\n", i);
+        run(n, niter, chunk_mb);
+        fflush(stdout);
+    }
+
+    return 0;
+}
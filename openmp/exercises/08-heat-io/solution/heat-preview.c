@@ -0,0 +1,219 @@
+/*
+ * SPDX-FileCopyrightText: 2026 CSC - IT Center for Science Ltd. <www.csc.fi>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// As heat-1.c, with frequent monitoring outputs that are reduced on the
+// device before the transfer: a downsampled preview of the whole grid and a
+// window at full resolution every 100 steps, and the full field only every
+// 1000 steps.
+//
+// Usage: ./heat-preview [n] [niter] [nrep] [preview stride]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <omp.h>
+#include "heat_helper_functions.h"
+#include "heat_stats.h"
+#include "heat_view.h"
+
+
+int run(const int n, const int niter, const int stride)
+{
+    // Grid size
+    const int nx = n, ny = n;
+    const int n2 = nx * ny;
+
+    // Box size
+    const double Lx = 8.0;
+    const double Ly = 8.0;
+
+    // Diffusivity
+    const double alpha = 0.5;
+
+    // Grid spacing
+    const double dx = Lx / (nx - 1);
+    const double dy = Ly / (ny - 1);
+    const double dx2 = dx * dx;
+    const double dy2 = dy * dy;
+
+    // Largest stable time step
+    const double dt = dx2 * dy2 / (2.0 * alpha * (dx2 + dy2));
+
+    // Print inputs
+    printf("Inputs: n = %d, niter = %d\n", n, niter);
+    printf("Diffusivity: %.2f\n", alpha);
+    printf("Box: %.2f x %.2f discretized with grid spacing %.2e x %.2e\n", Lx, Ly, dx, dy);
+    printf("Time propagation until %.2e with time step %.2e\n", dt * niter, dt);
+
+    const double rx = alpha * dt / dx2;
+    const double ry = alpha * dt / dy2;
+
+    double *u, *unew;
+    u = (double*)malloc(n2 * sizeof(double));
+    unew = (double*)malloc(n2 * sizeof(double));
+
+    // Initialize arrays
+    create_input(u, nx, ny, Lx, Ly);
+    memset(unew, 0, n2 * sizeof(double));
+
+    // Write initial arrays
+    write_array("u_initial.bin", u, nx, ny, Lx, Ly);
+
+    // Monitoring outputs computed on the device (see heat_view.h): the whole
+    // grid at 1/stride resolution and the central window at full resolution
+    heat_view_t preview, window;
+    int failed = heat_view_init(&preview, nx, ny, Lx, Ly, 0, ny, 0, nx, stride);
+    failed |= heat_view_init(&window, nx, ny, Lx, Ly, 3 * ny / 8, 5 * ny / 8, 3 * nx / 8, 5 * nx / 8, 1);
+    if (failed) {
+        heat_view_free(&window);
+        heat_view_free(&preview);
+        free(unew);
+        free(u);
+        return 1;
+    }
+    double full_bytes = 0.0;
+
+    // Propagate in time
+    double t0 = omp_get_wtime();
+
+#pragma omp target data map(tofrom: u[0:nx*ny]) map(to: unew[0:nx*ny])
+{
+
+    for (int it = 1; it < niter + 1; it++) {
+
+        // Stencil update
+        TRACE_PUSH("stencil enqueue");
+        #pragma omp target nowait depend(in: u[0:nx*ny]) depend(out: unew[0:nx*ny])
+        #pragma omp teams distribute parallel for collapse(2)
+        for (int i = 1; i < ny - 1; i++) {
+            for (int j = 1; j < nx - 1; j++) {
+                int ij = i * nx + j;
+                int ip = (i + 1) * nx + j;
+                int im = (i - 1) * nx + j;
+                int jp = i * nx + j + 1;
+                int jm = i * nx + j - 1;
+                unew[ij] = u[ij] + rx * (u[jp] - 2 * u[ij] + u[jm]) + ry * (u[ip] - 2 * u[ij] + u[im]);
+            }
+        }
+        TRACE_POP();
+
+        // Swap the arrays
+        double *tmp = u;
+        u = unew;
+        unew = tmp;
+
+        // Calculate statistics per quadrant
+        if (it % 100 == 0) {
+            heat_stats_t stats = heat_stats_init();
+
+            TRACE_PUSH("reduction");
+            #pragma omp target map(tofrom: stats) depend(in: u[0:nx*ny])
+            #pragma omp teams distribute parallel for collapse(2) reduction(heat_stats:stats)
+            for (int i = 0; i < ny; i++) {
+                for (int j = 0; j < nx; j++) {
+                    heat_stats_add(&stats, heat_quadrant(i, j, nx, ny), u[i * nx + j]);
+                }
+            }
+            TRACE_POP();
+
+            heat_stats_print(it, &stats, dx, dy);
+        }
+
+        // Write the reduced outputs
+        if (it % 100 == 0) {
+            TRACE_PUSH("views");
+            char filename[32];
+            heat_view_compute(&preview, u);
+            sprintf(filename, "preview_%06d.bin", it);
+            heat_view_write(&preview, filename);
+            heat_view_compute(&window, u);
+            sprintf(filename, "window_%06d.bin", it);
+            heat_view_write(&window, filename);
+            TRACE_POP();
+        }
+
+        // Write the full field
+        if (it % 1000 == 0) {
+            TRACE_PUSH("target update");
+            #pragma omp target update from(u[0:nx*ny]) depend(in: u[0:nx*ny])
+            TRACE_POP();
+            full_bytes += (double)nx * ny * sizeof(double);
+            char filename[20];
+            sprintf(filename, "u_%06d.bin", it);
+            write_array(filename, u, nx, ny, Lx, Ly);
+        }
+
+    }
+
+} // implicit wait at the end of the data clause
+
+    double t1 = omp_get_wtime();
+
+    // Write final result
+    int i = (ny - 1) / 2, j = (nx - 1) / 2;
+    printf("u[%d,%d] = %f\n", i, j, u[i * nx + j]);
+    printf("Time spent: %.3f s\n", t1 - t0);
+    printf("Transferred: preview %d x %d: %.3f MB, window %d x %d: %.3f MB, full field: %.3f MB\n",
+           preview.nx, preview.ny, 1.0e-6 * preview.bytes,
+           window.nx, window.ny, 1.0e-6 * window.bytes, 1.0e-6 * full_bytes);
+    heat_view_free(&window);
+    heat_view_free(&preview);
+    write_array("u_final.bin", u, nx, ny, Lx, Ly);
+
+    free(unew);
+    free(u);
+    return 0;
+}
+
+
+int main(int argc, char *argv[])
+{
+    // Default values
+    int n = 1024;
+    int niter = 500;
+    int nrep = 3;
+    int stride = 8;
+
+    if (argc > 1) {
+        n = atoi(argv[1]);
+        if (n < 1) {
+            printf("Size needs to be greater than zero.\n");
+            return 1;
+        }
+    }
+    if (argc > 2) {
+        niter = atoi(argv[2]);
+        if (niter < 1) {
+            printf("Number of iterations need to be greater than zero.\n");
+            return 1;
+        }
+    }
+    if (argc > 3) {
+        nrep = atoi(argv[3]);
+        if (nrep < 1) {
+            printf("Number of repetitions need to be greater than zero.\n");
+            return 1;
+        }
+    }
+
+    if (argc > 4) {
+        stride = atoi(argv[4]);
+        if (stride < 1) {
+            printf("Preview stride needs to be greater than zero.\n");
+            return 1;
+        }
+    }
+
+    for (int i = 0; i < nrep; i++) {
+        printf("RUN %d\n", i);
+        if (run(n, niter, stride)) {
+            return 1;
+        }
+        fflush(stdout);
+    }
+
+    return 0;
+}
@@ -0,0 +1 @@
+../../heat_staging.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../heat_view.h
\ No newline at end of file
@@ -0,0 +1 @@
+../../snapshot_writer.h
\ No newline at end of file
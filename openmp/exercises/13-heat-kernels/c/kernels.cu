@@ -10,33 +10,60 @@
 #endif
 
 
+// The grid is stored as T and the update is computed as Acc
+template <typename T, typename Acc>
 __global__ static
-void evolve_kernel(double *unew, const double *u,
+void evolve_kernel(T *unew, const T *u,
                    const int nx, const int ny,
-                   const double rx, const double ry)
+                   const Acc rx, const Acc ry)
 {
     int i = blockIdx.x * blockDim.x + threadIdx.x + nx;
 
     if (i < (ny - 1) * nx) {
         int m = i % nx;
         if (m > 0 && m < nx - 1) {
-            unew[i] = u[i] + rx * (u[i+1] - 2 * u[i] + u[i-1])
-                           + ry * (u[i+nx] - 2 * u[i] + u[i-nx]);
+            Acc ui = u[i];
+            unew[i] = ui + rx * (Acc(u[i+1]) - 2 * ui + Acc(u[i-1]))
+                         + ry * (Acc(u[i+nx]) - 2 * ui + Acc(u[i-nx]));
         }
     }
 }
 
 
+template <typename T, typename Acc>
+static
+void launch_evolve(T *unew, const T *u,
+                   const int nx, const int ny,
+                   const Acc rx, const Acc ry)
+{
+    int block = 128;
+    int grid = ((ny - 2) * nx + block - 1) / block;
+    evolve_kernel<T, Acc><<<grid, block>>>(unew, u, nx, ny, rx, ry);
+    cudaDeviceSynchronize();
+}
+
+
 extern "C" {
 
 void evolve(double *unew, const double *u,
             const int nx, const int ny,
             const double rx, const double ry)
 {
-    int block = 128;
-    int grid = ((ny - 2) * nx + block - 1) / block;
-    evolve_kernel<<<grid, block>>>(unew, u, nx, ny, rx, ry);
-    cudaDeviceSynchronize();
+    launch_evolve(unew, u, nx, ny, rx, ry);
+}
+
+void evolve_float(float *unew, const float *u,
+                  const int nx, const int ny,
+                  const float rx, const float ry)
+{
+    launch_evolve(unew, u, nx, ny, rx, ry);
+}
+
+void evolve_mixed(float *unew, const float *u,
+                  const int nx, const int ny,
+                  const double rx, const double ry)
+{
+    launch_evolve(unew, u, nx, ny, rx, ry);
 }
 
 }
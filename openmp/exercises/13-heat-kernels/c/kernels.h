@@ -2,6 +2,37 @@
 //
 // SPDX-License-Identifier: MIT
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 void evolve(double *unew, const double *u,
             const int nx, const int ny,
             const double rx, const double ry);
+
+// Single precision storage, computed in single precision
+void evolve_float(float *unew, const float *u,
+                  const int nx, const int ny,
+                  const float rx, const float ry);
+
+// Single precision storage, computed in double precision
+void evolve_mixed(float *unew, const float *u,
+                  const int nx, const int ny,
+                  const double rx, const double ry);
+
+// Stencil shapes of evolve_stencil()
+enum { STENCIL_CROSS = 0, STENCIL_BOX = 1 };
+
+// Stencil of the given shape and radius, with each thread updating tile
+// consecutive grid points. The implemented combinations are the cross with
+// radius 1 or 2 and the box with radius 1, each with tile 1, 8 or 32; see
+// solution/c/stencil.hpp. Returns 0 on success and 1 if the combination is
+// not implemented.
+int evolve_stencil(double *unew, const double *u,
+                   const int nx, const int ny,
+                   const double rx, const double ry,
+                   const int shape, const int radius, const int tile);
+
+#ifdef __cplusplus
+}
+#endif
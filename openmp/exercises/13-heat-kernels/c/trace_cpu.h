@@ -0,0 +1 @@
+../../trace_cpu.h
\ No newline at end of file
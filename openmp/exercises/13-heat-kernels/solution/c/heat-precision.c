@@ -0,0 +1,241 @@
+/*
+ * SPDX-FileCopyrightText: 2026 CSC - IT Center for Science Ltd. <www.csc.fi>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// Heat equation in double, single and mixed precision
+//
+// The stencil update reads and writes the whole grid at every step, so it is
+// bound by memory bandwidth and storing the grid as float halves the traffic.
+// The mixed version stores float but computes each update in double.
+// The error of the final field is measured against the double precision run.
+//
+// Usage: ./heat-precision.x [n] [niter] [nrep]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <omp.h>
+#include "kernels.h"
+#include "heat_helper_functions.h"
+#include "bench.h"
+
+typedef enum { PRECISION_DOUBLE, PRECISION_FLOAT, PRECISION_MIXED } precision_t;
+
+static const char *precision_name[] = {"double", "float", "mixed"};
+
+typedef struct {
+    int nx, ny;
+    double Lx, Ly;
+    double rx, ry;
+} heat_params_t;
+
+
+heat_params_t heat_params(const int n)
+{
+    heat_params_t p;
+
+    // Grid size
+    p.nx = n;
+    p.ny = n;
+
+    // Box size
+    p.Lx = 8.0;
+    p.Ly = 8.0;
+
+    // Diffusivity
+    const double alpha = 0.5;
+
+    // Grid spacing
+    const double dx = p.Lx / (p.nx - 1);
+    const double dy = p.Ly / (p.ny - 1);
+    const double dx2 = dx * dx;
+    const double dy2 = dy * dy;
+
+    // Largest stable time step
+    const double dt = dx2 * dy2 / (2.0 * alpha * (dx2 + dy2));
+
+    p.rx = alpha * dt / dx2;
+    p.ry = alpha * dt / dy2;
+    return p;
+}
+
+
+// Propagate in double precision. Returns the time and the final field in u.
+double run_double(const heat_params_t *p, const int niter, double *u)
+{
+    const int nx = p->nx, ny = p->ny;
+    const int n2 = nx * ny;
+    double *unew = (double*)malloc(n2 * sizeof(double));
+
+    create_input(u, nx, ny, p->Lx, p->Ly);
+    memset(unew, 0, n2 * sizeof(double));
+
+    double *u0 = u;
+    double t0 = omp_get_wtime();
+
+#pragma omp target data map(tofrom: u[0:nx*ny]) map(to: unew[0:nx*ny])
+{
+    for (int it = 1; it < niter + 1; it++) {
+        #pragma omp target data use_device_ptr(u, unew)
+        evolve(unew, u, nx, ny, p->rx, p->ry);
+
+        double *tmp = u;
+        u = unew;
+        unew = tmp;
+    }
+}
+
+    double t1 = omp_get_wtime();
+
+    // Return the final field in the array given by the caller
+    if (u != u0) {
+        memcpy(u0, u, n2 * sizeof(double));
+        unew = u;
+    }
+    free(unew);
+
+    return t1 - t0;
+}
+
+
+// Propagate with single precision storage, computing the updates in float or
+// double. Returns the time and the final field in u.
+double run_float(const heat_params_t *p, const int niter, const precision_t precision, float *u)
+{
+    const int nx = p->nx, ny = p->ny;
+    const int n2 = nx * ny;
+    float *unew = (float*)malloc(n2 * sizeof(float));
+
+    // The initial field is created in double and rounded to float
+    double *input = (double*)malloc(n2 * sizeof(double));
+    create_input(input, nx, ny, p->Lx, p->Ly);
+    for (int ij = 0; ij < n2; ij++) {
+        u[ij] = (float)input[ij];
+    }
+    free(input);
+    memset(unew, 0, n2 * sizeof(float));
+
+    const float rx = (float)p->rx, ry = (float)p->ry;
+    float *u0 = u;
+    double t0 = omp_get_wtime();
+
+#pragma omp target data map(tofrom: u[0:nx*ny]) map(to: unew[0:nx*ny])
+{
+    for (int it = 1; it < niter + 1; it++) {
+        #pragma omp target data use_device_ptr(u, unew)
+        {
+            if (precision == PRECISION_MIXED) {
+                evolve_mixed(unew, u, nx, ny, p->rx, p->ry);
+            } else {
+                evolve_float(unew, u, nx, ny, rx, ry);
+            }
+        }
+
+        float *tmp = u;
+        u = unew;
+        unew = tmp;
+    }
+}
+
+    double t1 = omp_get_wtime();
+
+    if (u != u0) {
+        memcpy(u0, u, n2 * sizeof(float));
+        unew = u;
+    }
+    free(unew);
+
+    return t1 - t0;
+}
+
+
+int main(int argc, char *argv[])
+{
+    // Default values
+    int n = 1024;
+    int niter = 500;
+    int nrep = 3;
+
+    if (argc > 1) {
+        n = atoi(argv[1]);
+        if (n < 1) {
+            printf("Size needs to be greater than zero.\n");
+            return 1;
+        }
+    }
+    if (argc > 2) {
+        niter = atoi(argv[2]);
+        if (niter < 1) {
+            printf("Number of iterations need to be greater than zero.\n");
+            return 1;
+        }
+    }
+    if (argc > 3) {
+        nrep = atoi(argv[3]);
+        if (nrep < 1) {
+            printf("Number of repetitions need to be greater than zero.\n");
+            return 1;
+        }
+    }
+
+    const heat_params_t p = heat_params(n);
+    const int n2 = p.nx * p.ny;
+    printf("Inputs: n = %d, niter = %d\n", n, niter);
+
+    double *reference = (double*)malloc(n2 * sizeof(double));
+    float *u = (float*)malloc(n2 * sizeof(float));
+
+    char config[256];
+    snprintf(config, sizeof(config), "n=%d niter=%d", n, niter);
+
+    printf("\n%-8s %12s %12s %12s %12s\n", "storage", "steps/s", "GB/s", "max error", "rms error");
+
+    for (int k = PRECISION_DOUBLE; k <= PRECISION_MIXED; k++) {
+        char name[64];
+        snprintf(name, sizeof(name), "heat-%s", precision_name[k]);
+        bench_t bench;
+        bench_init(&bench, name, config, 1, nrep);
+
+        for (int r = 0; r < bench_total_runs(&bench); r++) {
+            if (k == PRECISION_DOUBLE) {
+                bench_add(&bench, run_double(&p, niter, reference));
+            } else {
+                bench_add(&bench, run_float(&p, niter, (precision_t)k, u));
+            }
+        }
+
+        // Error of the final field against the double precision run
+        double max_error = 0.0, sum2 = 0.0;
+        if (k != PRECISION_DOUBLE) {
+            for (int ij = 0; ij < n2; ij++) {
+                double e = fabs((double)u[ij] - reference[ij]);
+                max_error = fmax(max_error, e);
+                sum2 += e * e;
+            }
+        }
+
+        // Each update reads and writes one grid point (assuming the
+        // neighbours are served from cache)
+        const double size = k == PRECISION_DOUBLE ? sizeof(double) : sizeof(float);
+        bench_stats_t stats = bench_report(&bench, niter, "steps/s");
+        printf("%-8s %12.1f %12.1f %12.3e %12.3e\n", precision_name[k], stats.throughput,
+               1.0e-9 * 2.0 * size * n2 * niter / stats.median, max_error, sqrt(sum2 / n2));
+        bench_free(&bench);
+
+        char filename[64];
+        snprintf(filename, sizeof(filename), "u_final_%s.bin", precision_name[k]);
+        if (k == PRECISION_DOUBLE) {
+            write_array(filename, reference, p.nx, p.ny, p.Lx, p.Ly);
+        } else {
+            write_array_dtype(filename, u, HEAT_DTYPE_FLOAT32, p.nx, p.ny, p.Lx, p.Ly);
+        }
+    }
+
+    free(u);
+    free(reference);
+
+    return 0;
+}
@@ -10,9 +10,11 @@
 #include <omp.h>
 #include "kernels.h"
 #include "heat_helper_functions.h"
+#include "bench.h"
+#include "perf_regions.h"
 
 
-void run(const int n, const int niter)
+double run(const int n, const int niter)
 {
     // Grid size
     const int nx = n, ny = n;
@@ -63,8 +65,10 @@ void run(const int n, const int niter)
     for (int it = 1; it < niter + 1; it++) {
 
         // Stencil update
+        PERF_REGION_BEGIN("evolve");
         #pragma omp target data use_device_ptr(u, unew)
         evolve(unew, u, nx, ny, rx, ry);
+        PERF_REGION_END("evolve", (nx - 2.0) * (ny - 2.0));
 
         // Swap the arrays
         double *tmp = u;
@@ -84,6 +88,8 @@ void run(const int n, const int niter)
 
     free(unew);
     free(u);
+
+    return t1 - t0;
 }
 
 
@@ -116,11 +122,21 @@ int main(int argc, char *argv[])
         }
     }
 
-    for (int i = 0; i < nrep; i++) {
+    char config[256];
+    snprintf(config, sizeof(config), "n=%d niter=%d", n, niter);
+    bench_t bench;
+    bench_init(&bench, "heat", config, 0, nrep);
+
+    for (int i = 0; i < bench_total_runs(&bench); i++) {
         printf("RUN %d\n", i);
-        run(n, niter);
+        bench_add(&bench, run(n, niter));
         fflush(stdout);
     }
 
+    // One stencil update per grid point and time step
+    bench_stats_t stats = bench_report(&bench, 1.0e-6 * n * n * niter, "Mupdates/s");
+    bench_print(&bench, &stats);
+    bench_free(&bench);
+
     return 0;
 }
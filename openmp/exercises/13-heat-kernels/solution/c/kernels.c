@@ -16,3 +16,36 @@ void evolve(double *unew, const double *u,
         }
     }
 }
+
+
+void evolve_float(float *unew, const float *u,
+                  const int nx, const int ny,
+                  const float rx, const float ry)
+{
+    #pragma omp target
+    #pragma omp teams distribute parallel for
+    for (int i = nx; i < (ny - 1) * nx; i++) {
+        int m = i % nx;
+        if (m > 0 && m < nx - 1) {
+            unew[i] = u[i] + rx * (u[i+1] - 2 * u[i] + u[i-1])
+                           + ry * (u[i+nx] - 2 * u[i] + u[i-nx]);
+        }
+    }
+}
+
+
+void evolve_mixed(float *unew, const float *u,
+                  const int nx, const int ny,
+                  const double rx, const double ry)
+{
+    #pragma omp target
+    #pragma omp teams distribute parallel for
+    for (int i = nx; i < (ny - 1) * nx; i++) {
+        int m = i % nx;
+        if (m > 0 && m < nx - 1) {
+            double ui = u[i];
+            unew[i] = ui + rx * ((double)u[i+1] - 2 * ui + u[i-1])
+                         + ry * ((double)u[i+nx] - 2 * ui + u[i-nx]);
+        }
+    }
+}
@@ -0,0 +1,159 @@
+// SPDX-FileCopyrightText: 2026 CSC - IT Center for Science Ltd. <www.csc.fi>
+//
+// SPDX-License-Identifier: MIT
+
+// Benchmark of the stencil specialisations in stencil.hpp against evolve()
+//
+// Usage: ./stencil-bench.x [n] [niter] [nrep]
+//
+// All variants use half of the largest stable time step of the 5-point
+// stencil, which is stable for all of them. The difference of the final
+// field from evolve() is zero up to rounding for the 5-point stencil. The
+// final field of evolve() is written to u_final.bin.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <omp.h>
+#include "kernels.h"
+#include "heat_helper_functions.h"
+#include "bench.h"
+
+struct Variant {
+  const char *name;
+  int shape;
+  int radius;
+  int tile;
+};
+
+// Propagate niter steps starting from u0, with the stencil of the variant or
+// evolve() if variant is null. Returns the time and the final field in u.
+static double propagate(const Variant *variant, const std::vector<double> &u0,
+                        std::vector<double> &u, const int nx, const int ny,
+                        const int niter, const double rx, const double ry)
+{
+  // Both arrays start from the initial field, so that the points next to
+  // the edge have the same values in both
+  std::vector<double> work = u0;
+  u = u0;
+  double *a = u.data(), *b = work.data();
+
+  double t0 = omp_get_wtime();
+
+#pragma omp target data map(tofrom: a[0:nx*ny]) map(to: b[0:nx*ny])
+{
+  for (int it = 1; it < niter + 1; it++) {
+    #pragma omp target data use_device_ptr(a, b)
+    {
+      if (variant == nullptr) {
+        evolve(b, a, nx, ny, rx, ry);
+      } else {
+        evolve_stencil(b, a, nx, ny, rx, ry, variant->shape, variant->radius, variant->tile);
+      }
+    }
+    std::swap(a, b);
+  }
+}
+
+  double t1 = omp_get_wtime();
+
+  if (a != u.data()) {
+    u.swap(work);
+  }
+  return t1 - t0;
+}
+
+int main(int argc, char *argv[])
+{
+  // Default values
+  int n = 1024;
+  int niter = 500;
+  int nrep = 3;
+
+  if (argc > 1) {
+    n = atoi(argv[1]);
+    if (n < 5) {
+      printf("Size needs to be at least 5.\n");
+      return 1;
+    }
+  }
+  if (argc > 2) {
+    niter = atoi(argv[2]);
+    if (niter < 1) {
+      printf("Number of iterations need to be greater than zero.\n");
+      return 1;
+    }
+  }
+  if (argc > 3) {
+    nrep = atoi(argv[3]);
+    if (nrep < 1) {
+      printf("Number of repetitions need to be greater than zero.\n");
+      return 1;
+    }
+  }
+
+  const int nx = n, ny = n;
+  const double Lx = 8.0, Ly = 8.0;
+  const double alpha = 0.5;
+  const double dx = Lx / (nx - 1);
+  const double dy = Ly / (ny - 1);
+  const double dx2 = dx * dx;
+  const double dy2 = dy * dy;
+  const double dt = 0.5 * dx2 * dy2 / (2.0 * alpha * (dx2 + dy2));
+  const double rx = alpha * dt / dx2;
+  const double ry = alpha * dt / dy2;
+
+  printf("Inputs: n = %d, niter = %d\n", n, niter);
+
+  std::vector<double> u0(nx * ny), reference, u;
+  create_input(u0.data(), nx, ny, Lx, Ly);
+
+  const Variant variants[] = {
+    {"cross r1 tile 1", STENCIL_CROSS, 1, 1},
+    {"cross r1 tile 8", STENCIL_CROSS, 1, 8},
+    {"cross r1 tile 32", STENCIL_CROSS, 1, 32},
+    {"cross r2 tile 1", STENCIL_CROSS, 2, 1},
+    {"cross r2 tile 8", STENCIL_CROSS, 2, 8},
+    {"cross r2 tile 32", STENCIL_CROSS, 2, 32},
+    {"box r1 tile 1", STENCIL_BOX, 1, 1},
+    {"box r1 tile 8", STENCIL_BOX, 1, 8},
+    {"box r1 tile 32", STENCIL_BOX, 1, 32},
+  };
+  const int nvariant = sizeof(variants) / sizeof(variants[0]);
+
+  char config[256];
+  snprintf(config, sizeof(config), "n=%d niter=%d", n, niter);
+
+  printf("\n%-18s %12s %12s %14s\n", "stencil", "Mupdates/s", "time (s)", "diff evolve()");
+
+  for (int v = -1; v < nvariant; v++) {
+    const Variant *variant = v < 0 ? nullptr : &variants[v];
+    const char *label = v < 0 ? "evolve()" : variant->name;
+
+    char name[64];
+    snprintf(name, sizeof(name), "stencil %s", label);
+    bench_t bench;
+    bench_init(&bench, name, config, 1, nrep);
+    for (int r = 0; r < bench_total_runs(&bench); r++) {
+      bench_add(&bench, propagate(variant, u0, u, nx, ny, niter, rx, ry));
+    }
+    bench_stats_t stats = bench_report(&bench, 1.0e-6 * nx * ny * niter, "Mupdates/s");
+    bench_free(&bench);
+
+    if (variant == nullptr) {
+      reference = u;
+      write_array("u_final.bin", reference.data(), nx, ny, Lx, Ly);
+    }
+    double diff = 0.0;
+    for (int ij = 0; ij < nx * ny; ij++) {
+      diff = std::max(diff, std::fabs(u[ij] - reference[ij]));
+    }
+
+    printf("%-18s %12.1f %12.4f %14.3e\n", label, stats.throughput, stats.median, diff);
+  }
+
+  return 0;
+}
@@ -0,0 +1,46 @@
+// SPDX-FileCopyrightText: 2026 CSC - IT Center for Science Ltd. <www.csc.fi>
+//
+// SPDX-License-Identifier: MIT
+
+// C-callable dispatcher over the specialisations in stencil.hpp
+
+#include "kernels.h"
+#include "stencil.hpp"
+
+using stencil::Shape;
+
+template <Shape S, int Radius>
+static int evolve_tile(double *unew, const double *u, const int nx, const int ny,
+                       const double rx, const double ry, const int tile)
+{
+  switch (tile) {
+  case 1:
+    stencil::evolve<S, Radius, 1>(unew, u, nx, ny, rx, ry);
+    return 0;
+  case 8:
+    stencil::evolve<S, Radius, 8>(unew, u, nx, ny, rx, ry);
+    return 0;
+  case 32:
+    stencil::evolve<S, Radius, 32>(unew, u, nx, ny, rx, ry);
+    return 0;
+  default:
+    return 1;
+  }
+}
+
+extern "C" int evolve_stencil(double *unew, const double *u,
+                              const int nx, const int ny,
+                              const double rx, const double ry,
+                              const int shape, const int radius, const int tile)
+{
+  if (shape == STENCIL_CROSS && radius == 1) {
+    return evolve_tile<Shape::cross, 1>(unew, u, nx, ny, rx, ry, tile);
+  }
+  if (shape == STENCIL_CROSS && radius == 2) {
+    return evolve_tile<Shape::cross, 2>(unew, u, nx, ny, rx, ry, tile);
+  }
+  if (shape == STENCIL_BOX && radius == 1) {
+    return evolve_tile<Shape::box, 1>(unew, u, nx, ny, rx, ry, tile);
+  }
+  return 1;
+}
@@ -0,0 +1,105 @@
+// SPDX-FileCopyrightText: 2026 CSC - IT Center for Science Ltd. <www.csc.fi>
+//
+// SPDX-License-Identifier: MIT
+
+// Heat equation stencils specialised at compile time
+//
+// The shape, radius and tile width are template parameters, so the
+// neighbour loops have constant trip counts and the compiler can unroll
+// and vectorise them:
+//
+//   stencil::evolve<stencil::Shape::cross, 2, 8>(unew, u, nx, ny, rx, ry);
+//
+// - Shape::cross with radius 1 is the 5-point stencil of kernels.c, and with
+//   radius 2 the 9-point fourth order stencil along the axes.
+// - Shape::box with radius 1 is the compact 9-point stencil, the product of
+//   the explicit steps along x and y, (1 + rx d_xx)(1 + ry d_yy). It is
+//   consistent for any rx and ry, stable for rx, ry <= 1/2, and fourth order
+//   for rx == ry == 1/6.
+// - Each thread updates TileX consecutive grid points of one row.
+//
+// The grid points closer than the radius to the edge are not updated. The
+// fourth order stencil needs a time step of at most 3/4 of the second order
+// limit.
+//
+// The C-callable dispatcher evolve_stencil() is declared in kernels.h.
+
+#pragma once
+
+namespace stencil {
+
+enum class Shape { cross, box };
+
+// Weights of the central difference of the second derivative: the centre
+// for k = 0 and the two points at distance k otherwise
+template <int Radius>
+constexpr double weight(const int k);
+
+template <>
+constexpr double weight<1>(const int k)
+{
+  return k == 0 ? -2.0 : 1.0;
+}
+
+template <>
+constexpr double weight<2>(const int k)
+{
+  return k == 0 ? -5.0 / 2.0 : (k == 1 ? 4.0 / 3.0 : -1.0 / 12.0);
+}
+
+// New value of the grid point ij
+template <Shape S, int Radius>
+inline double update(const double *u, const int ij, const int nx,
+                     const double rx, const double ry)
+{
+  const double uij = u[ij];
+  double dxx = weight<Radius>(0) * uij;
+  double dyy = weight<Radius>(0) * uij;
+  for (int k = 1; k <= Radius; k++) {
+    dxx += weight<Radius>(k) * (u[ij + k] + u[ij - k]);
+    dyy += weight<Radius>(k) * (u[ij + k * nx] + u[ij - k * nx]);
+  }
+
+  if constexpr (S == Shape::box) {
+    static_assert(Radius == 1, "the box stencil is implemented for radius 1");
+    // The diagonal neighbours sum to about 4 u + 2 dx^2 u_xx + 2 dy^2 u_yy,
+    // so the weights of u_xx and u_yy remain rx and ry
+    const double diag = u[ij - nx - 1] + u[ij - nx + 1]
+                      + u[ij + nx - 1] + u[ij + nx + 1] - 4 * uij;
+    const double rxy = rx * ry;
+    return uij + (rx - 2 * rxy) * dxx + (ry - 2 * rxy) * dyy + rxy * diag;
+  } else {
+    return uij + rx * dxx + ry * dyy;
+  }
+}
+
+template <Shape S, int Radius, int TileX>
+void evolve(double *unew, const double *u, const int nx, const int ny,
+            const double rx, const double ry)
+{
+  static_assert(Radius >= 1 && TileX >= 1, "invalid stencil");
+  const int ntile = (nx - 2 * Radius + TileX - 1) / TileX;
+
+  #pragma omp target
+  #pragma omp teams distribute parallel for collapse(2)
+  for (int i = Radius; i < ny - Radius; i++) {
+    for (int t = 0; t < ntile; t++) {
+      const int j0 = Radius + t * TileX;
+      const int ij0 = i * nx + j0;
+      if (j0 + TileX <= nx - Radius) {
+        // Full tile with a constant trip count
+        #pragma omp simd
+        for (int jj = 0; jj < TileX; jj++) {
+          unew[ij0 + jj] = update<S, Radius>(u, ij0 + jj, nx, rx, ry);
+        }
+      } else {
+        // Last tile of the row
+        for (int jj = 0; jj < nx - Radius - j0; jj++) {
+          unew[ij0 + jj] = update<S, Radius>(u, ij0 + jj, nx, rx, ry);
+        }
+      }
+    }
+  }
+}
+
+} // namespace stencil
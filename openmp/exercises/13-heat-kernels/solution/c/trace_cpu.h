@@ -0,0 +1 @@
+../../c/trace_cpu.h
\ No newline at end of file
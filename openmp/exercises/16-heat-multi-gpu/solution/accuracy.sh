@@ -0,0 +1,29 @@
+#!/bin/bash
+
+# SPDX-FileCopyrightText: 2026 CSC - IT Center for Science Ltd. <www.csc.fi>
+#
+# SPDX-License-Identifier: MIT
+
+# Accuracy per cost of the stencils in heat-order.c: the maximum error at
+# t = 1 and the time to solution over a range of grid sizes
+
+#SBATCH --job-name=heat-order
+#SBATCH --partition=gpumedium
+#SBATCH --nodes=1
+#SBATCH --ntasks-per-node=4
+#SBATCH --cpus-per-task=18
+#SBATCH --gres=gpu:gh200:4
+#SBATCH --time=00:30:00
+
+set -euo pipefail
+
+cc=${cc:-"mpicc -mp=gpu -O3 -gpu=cc90"}
+launch=${launch:-srun}
+
+$cc heat-order.c -lm -o heat-order.x
+
+for stencil in 5 compact wide; do
+    for n in 129 257 513 1025 2049; do
+        $launch ./heat-order.x $n $stencil 1.0
+    done
+done
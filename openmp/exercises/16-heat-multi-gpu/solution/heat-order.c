@@ -0,0 +1,275 @@
+/*
+ * SPDX-FileCopyrightText: 2026 CSC - IT Center for Science Ltd. <www.csc.fi>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// Multi-GPU heat equation with a choice of stencil, for an accuracy study
+//
+// Usage: mpirun -np <ntasks> ./heat-order [n] [stencil] [t_end]
+//
+// The stencils are
+//   5        the 5-point second order stencil of heat.c
+//   compact  the compact 9-point stencil (including the diagonal neighbours),
+//            the product of the explicit steps (1 + rx d_xx)(1 + ry d_yy)
+//   wide     the fourth order 9-point stencil along the axes, which reaches
+//            two grid points in each direction and needs two halo rows
+//
+// The initial field is the lowest Fourier mode sin(pi x / Lx) sin(pi y / Ly),
+// with the exact solution decaying as exp(-alpha pi^2 (1/Lx^2 + 1/Ly^2) t),
+// so the maximum error at t_end can be measured.
+//
+// The time stepping is explicit Euler with an error proportional to dt,
+// and dt itself has to be proportional to dx^2 for stability. For the
+// compact stencil with rx = ry = 1/6, the leading errors of the time
+// stepping and of the stencil cancel and the scheme is fourth order overall.
+// The wide stencil is fourth order in space, but its total error remains
+// second order because of the time stepping.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <omp.h>
+#include <mpi.h>
+
+typedef enum { STENCIL_5, STENCIL_COMPACT, STENCIL_WIDE } stencil_t;
+
+static const char *stencil_name[] = {"5", "compact", "wide"};
+
+
+static inline
+int calculate_inner_size(const int n_full, const int rank, const int ntasks) {
+    const int n_full_inner = n_full - 2;  // Remove global boundary condition
+    return n_full_inner / ntasks + (rank < n_full_inner % ntasks);
+}
+
+
+int run(const int n, const stencil_t stencil, const double t_end)
+{
+    // Grid size
+    const int nx_full = n, ny_full = n;
+
+    int ntasks, rank;
+    MPI_Comm_size(MPI_COMM_WORLD, &ntasks);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    int nghbrs[2] = {rank-1, rank+1};
+    if (rank == 0) nghbrs[0] = MPI_PROC_NULL;
+    if (rank == ntasks - 1) nghbrs[1] = MPI_PROC_NULL;
+
+    // Number of halo rows on each side
+    const int nhalo = stencil == STENCIL_WIDE ? 2 : 1;
+
+    const int nx = nx_full;
+    const int ny_inner = calculate_inner_size(ny_full, rank, ntasks);
+    const int ny = ny_inner + 2 * nhalo;  // Add halo and/or boundary conditions to the array
+
+    // Global row of the first inner row
+    int i0 = 1;
+    for (int r = 0; r < rank; r++) {
+        i0 += calculate_inner_size(ny_full, r, ntasks);
+    }
+
+    int too_small = ny_inner < nhalo;
+    MPI_Allreduce(MPI_IN_PLACE, &too_small, 1, MPI_INT, MPI_LOR, MPI_COMM_WORLD);
+    if (too_small) {
+        if (rank == 0) {
+            printf("Each rank needs at least %d inner rows.\n", nhalo);
+        }
+        return 1;
+    }
+
+    // Box size
+    const double Lx = 8.0;
+    const double Ly = 8.0;
+
+    // Diffusivity
+    const double alpha = 0.5;
+
+    // Grid spacing
+    const double dx = Lx / (nx_full - 1);
+    const double dy = Ly / (ny_full - 1);
+    const double dx2 = dx * dx;
+    const double dy2 = dy * dy;
+
+    // Largest stable time step of the 5-point stencil, and rx = ry = 1/6 for
+    // the others (the compact stencil is fourth order only with that ratio)
+    double dt_max = dx2 * dy2 / (2.0 * alpha * (dx2 + dy2));
+    if (stencil != STENCIL_5) {
+        dt_max = fmin(dx2, dy2) / (6.0 * alpha);
+    }
+    const int niter = (int)ceil(t_end / dt_max);
+    const double dt = t_end / niter;
+
+    const double rx = alpha * dt / dx2;
+    const double ry = alpha * dt / dy2;
+
+    // Initial field, including the global boundary rows. The rows outside
+    // the grid are only allocated to give all ranks the same layout.
+    const int bytes = nx * ny * sizeof(double);
+    double *u = (double*)malloc(bytes);
+    double *unew = (double*)malloc(bytes);
+    memset(u, 0, bytes);
+    for (int i = 0; i < ny; i++) {
+        const int gi = i0 + i - nhalo;
+        if (gi < 0 || gi > ny_full - 1) {
+            continue;
+        }
+        for (int j = 0; j < nx; j++) {
+            u[i * nx + j] = sin(M_PI * j / (nx_full - 1)) * sin(M_PI * gi / (ny_full - 1));
+        }
+    }
+    memcpy(unew, u, bytes);
+
+    // Propagate in time
+    MPI_Barrier(MPI_COMM_WORLD);
+    double t0 = omp_get_wtime();
+
+#pragma omp target data map(tofrom: u[0:nx*ny]) map(to: unew[0:nx*ny])
+{
+    for (int it = 1; it < niter + 1; it++) {
+
+        // Halo exchange of nhalo rows
+        #pragma omp target data use_device_ptr(u)
+        {
+            double *u_first_halo = u;
+            double *u_first_inner = u + nx * nhalo;
+            double *u_last_halo = u + nx * (nhalo + ny_inner);
+            double *u_last_inner = u + nx * ny_inner;
+            MPI_Sendrecv(u_first_inner, nx * nhalo, MPI_DOUBLE, nghbrs[0], 123,
+                         u_last_halo, nx * nhalo, MPI_DOUBLE, nghbrs[1], 123,
+                         MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+            MPI_Sendrecv(u_last_inner, nx * nhalo, MPI_DOUBLE, nghbrs[1], 123,
+                         u_first_halo, nx * nhalo, MPI_DOUBLE, nghbrs[0], 123,
+                         MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        }
+
+        // Stencil update
+        #pragma omp target
+        #pragma omp teams distribute parallel for collapse(2)
+        for (int i = nhalo; i < nhalo + ny_inner; i++) {
+            for (int j = 1; j < nx - 1; j++) {
+                int ij = i * nx + j;
+                int ip = (i + 1) * nx + j;
+                int im = (i - 1) * nx + j;
+                int jp = i * nx + j + 1;
+                int jm = i * nx + j - 1;
+                double uxx = u[jp] - 2 * u[ij] + u[jm];
+                double uyy = u[ip] - 2 * u[ij] + u[im];
+
+                if (stencil == STENCIL_COMPACT) {
+                    // The diagonal neighbours sum to about 4 u + 2 dx^2 u_xx + 2 dy^2 u_yy,
+                    // so the weights of u_xx and u_yy remain rx and ry for any dx, dy
+                    double diag = u[im - 1] + u[im + 1] + u[ip - 1] + u[ip + 1] - 4 * u[ij];
+                    const double rxy = rx * ry;
+                    unew[ij] = u[ij] + (rx - 2 * rxy) * uxx + (ry - 2 * rxy) * uyy + rxy * diag;
+                    continue;
+                }
+
+                if (stencil == STENCIL_WIDE) {
+                    // Fourth order where two neighbours exist in the direction,
+                    // second order next to the global boundary
+                    const int gi = i0 + i - nhalo;
+                    if (j > 1 && j < nx - 2) {
+                        uxx = (-u[jp + 1] + 16 * u[jp] - 30 * u[ij] + 16 * u[jm] - u[jm - 1]) / 12.0;
+                    }
+                    if (gi > 1 && gi < ny_full - 2) {
+                        uyy = (-u[ip + nx] + 16 * u[ip] - 30 * u[ij] + 16 * u[im] - u[im - nx]) / 12.0;
+                    }
+                }
+
+                unew[ij] = u[ij] + rx * uxx + ry * uyy;
+            }
+        }
+
+        // Swap the arrays
+        double *tmp = u;
+        u = unew;
+        unew = tmp;
+
+    }
+
+} // implicit wait at the end of the data clause
+
+    double t1 = omp_get_wtime();
+
+    // Maximum error against the exact solution
+    const double decay = exp(-alpha * M_PI * M_PI * (1.0 / (Lx * Lx) + 1.0 / (Ly * Ly)) * niter * dt);
+    double error = 0.0;
+    for (int i = nhalo; i < nhalo + ny_inner; i++) {
+        const int gi = i0 + i - nhalo;
+        for (int j = 0; j < nx; j++) {
+            const double exact = decay * sin(M_PI * j / (nx_full - 1)) * sin(M_PI * gi / (ny_full - 1));
+            error = fmax(error, fabs(u[i * nx + j] - exact));
+        }
+    }
+    double time = t1 - t0;
+    MPI_Allreduce(MPI_IN_PLACE, &error, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+    MPI_Allreduce(MPI_IN_PLACE, &time, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+
+    if (rank == 0) {
+        printf("stencil %-8s n = %6d  niter = %8d  nhalo = %d  time %10.4f s  max error %.3e\n",
+               stencil_name[stencil], n, niter, nhalo, time, error);
+    }
+
+    free(unew);
+    free(u);
+    return 0;
+}
+
+
+int main(int argc, char *argv[])
+{
+    MPI_Init(&argc, &argv);
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    // Set device per rank
+    int count = omp_get_num_devices();
+    if (count > 0) {
+        omp_set_default_device(rank % count);
+    }
+
+    // Default values
+    int n = 256;
+    stencil_t stencil = STENCIL_5;
+    double t_end = 1.0;
+
+    if (argc > 1) {
+        n = atoi(argv[1]);
+        if (n < 6) {
+            if (rank == 0) printf("Size needs to be at least 6.\n");
+            MPI_Finalize();
+            return 1;
+        }
+    }
+    if (argc > 2) {
+        int found = 0;
+        for (int s = STENCIL_5; s <= STENCIL_WIDE; s++) {
+            if (strcmp(argv[2], stencil_name[s]) == 0) {
+                stencil = (stencil_t)s;
+                found = 1;
+            }
+        }
+        if (!found) {
+            if (rank == 0) printf("Stencil needs to be 5, compact or wide.\n");
+            MPI_Finalize();
+            return 1;
+        }
+    }
+    if (argc > 3) {
+        t_end = atof(argv[3]);
+        if (t_end <= 0.0) {
+            if (rank == 0) printf("End time needs to be greater than zero.\n");
+            MPI_Finalize();
+            return 1;
+        }
+    }
+
+    int status = run(n, stencil, t_end);
+
+    MPI_Finalize();
+
+    return status;
+}
@@ -0,0 +1,84 @@
+/*
+ * SPDX-FileCopyrightText: 2026 CSC - IT Center for Science Ltd. <www.csc.fi>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/*
+ * Compensated (Kahan-Babuska-Neumaier) floating point sums
+ *
+ * Every addition to the running sum loses the low-order bits of the
+ * smaller operand. Here the lost part is computed exactly and collected
+ * into a separate compensation term, which is added at the end:
+ *
+ *     csum_t sum = csum_zero();
+ *     #pragma omp parallel for reduction(csum:sum)
+ *     for (int i = 0; i < n; i++)
+ *         csum_add(&sum, x[i]);
+ *
+ *     double total = csum_result(&sum);
+ *
+ * The same works in target regions (map sum with tofrom). The error is
+ * about one rounding of the result plus n * eps^2 * sum(|x|), compared
+ * to n * eps * sum(|x|) for reduction(+). Unlike the reproducible sum in
+ * reproducible_sum.h, the result may still change in the last bit with
+ * the number of threads.
+ *
+ * Note! Do not compile with -ffast-math, it removes the compensation.
+ */
+
+#ifndef COMPENSATED_SUM_H
+#define COMPENSATED_SUM_H
+
+#include <math.h>
+
+#if defined(__FAST_MATH__)
+#error "compensated_sum.h does not work with -ffast-math"
+#endif
+
+typedef struct {
+    double sum;
+    double c;  // rounding errors of sum
+} csum_t;
+
+#pragma omp declare target
+
+static inline
+csum_t csum_zero(void)
+{
+    csum_t sum = {0.0, 0.0};
+    return sum;
+}
+
+static inline
+void csum_add(csum_t *sum, double x)
+{
+    double t = sum->sum + x;
+    // Exact rounding error of t, computed from the larger operand
+    if (fabs(sum->sum) >= fabs(x)) {
+        sum->c += (sum->sum - t) + x;
+    } else {
+        sum->c += (x - t) + sum->sum;
+    }
+    sum->sum = t;
+}
+
+static inline
+void csum_combine(csum_t *out, const csum_t *in)
+{
+    csum_add(out, in->sum);
+    out->c += in->c;
+}
+
+#pragma omp end declare target
+
+#pragma omp declare reduction(csum : csum_t : csum_combine(&omp_out, &omp_in)) \
+    initializer(omp_priv = csum_zero())
+
+static inline
+double csum_result(const csum_t *sum)
+{
+    return sum->sum + sum->c;
+}
+
+#endif
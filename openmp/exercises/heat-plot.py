@@ -17,8 +17,11 @@ def read_array(filename):
         # Read the array layout (0 = C, 1 = Fortran)
         layout = np.fromfile(f, dtype=np.uint8, count=1)[0]
 
+        # Read the element type (0 = float64, 1 = float32)
+        dtype = np.fromfile(f, dtype=np.uint8, count=1)[0]
+
         # Read the array
-        array = np.fromfile(f, dtype=np.float64, count=nx * ny)
+        array = np.fromfile(f, dtype=np.float32 if dtype == 1 else np.float64, count=nx * ny)
 
     array = array.reshape(ny, nx)
     if layout == 1:
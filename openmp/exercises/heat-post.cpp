@@ -0,0 +1,534 @@
+// SPDX-FileCopyrightText: 2026 CSC - IT Center for Science Ltd. <www.csc.fi>
+//
+// SPDX-License-Identifier: MIT
+
+// Post-processing of large heat equation snapshots (u_*.bin)
+//
+// heat-plot.py reads the whole file into memory, which is slow and needs
+// many gigabytes for large grids. This tool reads the files in chunks of
+// rows, so that its memory use does not grow with the grid size, and
+// processes each chunk in parallel with OpenMP:
+//
+//   heat-post stats u_final.bin
+//   heat-post diff u_001000.bin u_002000.bin
+//   heat-post image u_final.bin u_final.png [--width 1024] [--window i0:i1,j0:j1] [--tiles 4]
+//
+// `image` averages blocks of grid points down to at most `width` pixels
+// per side, and draws them with the colour map and orientation of
+// heat-plot.py (y upwards). With --window only the given rows i and columns
+// j of the grid are read and drawn. With --tiles N the window is split into
+// N x N tiles written to separate files (name_<tile row>_<tile column>.png,
+// tile row 0 at the bottom), all with the same colour scale, e.g. to view a
+// large grid at full resolution piece by piece. The images are written as
+// PPM, or as PNG without compression so that no libraries are needed.
+//
+// The chunk size is 64 MB by default and can be changed with --chunk-mb.
+// `image` reads each band of pixel rows in blocks of pixel columns within
+// the chunk size.
+//
+// Build: g++ -std=c++17 -O3 -fopenmp heat-post.cpp -o heat-post
+
+#include <sys/types.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+// File format of write_array(): the box size, the array size, the layout
+// (0 = C order, 1 = Fortran order) and the element type (0 = float64,
+// 1 = float32), followed by the data
+struct Header {
+  double Lx, Ly;
+  uint64_t nx, ny;
+  uint8_t layout, dtype;
+
+  // The data is stored as rows() rows of cols() values: the rows of the
+  // grid in C order and its columns in Fortran order
+  uint64_t rows() const { return layout == 1 ? nx : ny; }
+  uint64_t cols() const { return layout == 1 ? ny : nx; }
+  size_t element_size() const { return dtype == 1 ? sizeof(float) : sizeof(double); }
+};
+
+constexpr off_t header_size = 2 * sizeof(double) + 2 * sizeof(uint64_t) + 2;
+
+class Snapshot {
+public:
+  explicit Snapshot(const std::string &filename) : filename_(filename)
+  {
+    file_ = std::fopen(filename.c_str(), "rb");
+    if (file_ == nullptr) {
+      throw std::runtime_error("cannot open " + filename);
+    }
+    bool ok = std::fread(&h_.Lx, sizeof(double), 1, file_) == 1
+           && std::fread(&h_.Ly, sizeof(double), 1, file_) == 1
+           && std::fread(&h_.nx, sizeof(uint64_t), 1, file_) == 1
+           && std::fread(&h_.ny, sizeof(uint64_t), 1, file_) == 1
+           && std::fread(&h_.layout, 1, 1, file_) == 1
+           && std::fread(&h_.dtype, 1, 1, file_) == 1;
+    if (!ok || h_.layout > 1 || h_.dtype > 1 || h_.nx < 2 || h_.ny < 2) {
+      std::fclose(file_);
+      throw std::runtime_error(filename + ": invalid header");
+    }
+
+    // The size also catches files written before the element type byte
+    fseeko(file_, 0, SEEK_END);
+    const off_t expected = header_size + (off_t)(h_.nx * h_.ny * h_.element_size());
+    if (ftello(file_) != expected) {
+      std::fclose(file_);
+      throw std::runtime_error(filename + ": file size does not match the header");
+    }
+  }
+
+  ~Snapshot() { std::fclose(file_); }
+  Snapshot(const Snapshot &) = delete;
+  Snapshot &operator=(const Snapshot &) = delete;
+
+  const Header &header() const { return h_; }
+  const std::string &filename() const { return filename_; }
+
+  // Read the values c0 <= c < c1 of the rows r0 <= r < r1 into data
+  void read(const uint64_t r0, const uint64_t r1, const uint64_t c0, const uint64_t c1,
+            std::vector<double> &data)
+  {
+    const uint64_t width = c1 - c0;
+    const size_t size = h_.element_size();
+    data.resize((r1 - r0) * width);
+    raw_.resize((r1 - r0) * width * size);
+
+    if (width == h_.cols()) {
+      // Whole rows are contiguous in the file
+      fseeko(file_, header_size + (off_t)(r0 * h_.cols() * size), SEEK_SET);
+      check(std::fread(raw_.data(), size, data.size(), file_) == data.size());
+    } else {
+      for (uint64_t r = r0; r < r1; r++) {
+        fseeko(file_, header_size + (off_t)((r * h_.cols() + c0) * size), SEEK_SET);
+        check(std::fread(raw_.data() + (r - r0) * width * size, size, width, file_) == width);
+      }
+    }
+
+    const int64_t n = data.size();
+    if (h_.dtype == 1) {
+      const float *values = reinterpret_cast<const float *>(raw_.data());
+      #pragma omp parallel for
+      for (int64_t k = 0; k < n; k++) {
+        data[k] = values[k];
+      }
+    } else {
+      std::memcpy(data.data(), raw_.data(), n * sizeof(double));
+    }
+  }
+
+private:
+  void check(const bool ok) const
+  {
+    if (!ok) {
+      throw std::runtime_error(filename_ + ": read failed");
+    }
+  }
+
+  std::string filename_;
+  FILE *file_;
+  Header h_;
+  std::vector<char> raw_;
+};
+
+// Window of the stored data: rows r0 <= r < r1 and columns c0 <= c < c1
+struct Window {
+  uint64_t r0, r1, c0, c1;
+};
+
+// Number of stored rows per chunk for the given row width
+uint64_t chunk_rows(const uint64_t width, const double chunk_mb)
+{
+  return std::max<uint64_t>(1, (uint64_t)(chunk_mb * 1.0e6 / (width * sizeof(double))));
+}
+
+struct Stats {
+  uint64_t count = 0;
+  double sum = 0.0;
+  double sum2 = 0.0;
+  double min = std::numeric_limits<double>::infinity();
+  double max = -std::numeric_limits<double>::infinity();
+};
+
+Stats statistics(Snapshot &snapshot, const Window &w, const double chunk_mb)
+{
+  Stats s;
+  std::vector<double> data;
+  const uint64_t nrow = chunk_rows(w.c1 - w.c0, chunk_mb);
+  for (uint64_t r = w.r0; r < w.r1; r += nrow) {
+    snapshot.read(r, std::min(r + nrow, w.r1), w.c0, w.c1, data);
+    const int64_t n = data.size();
+    double sum = 0.0, sum2 = 0.0;
+    double min = s.min, max = s.max;
+    #pragma omp parallel for reduction(+:sum, sum2) reduction(min:min) reduction(max:max)
+    for (int64_t k = 0; k < n; k++) {
+      sum += data[k];
+      sum2 += data[k] * data[k];
+      min = std::min(min, data[k]);
+      max = std::max(max, data[k]);
+    }
+    s.count += n;
+    s.sum += sum;
+    s.sum2 += sum2;
+    s.min = min;
+    s.max = max;
+  }
+  return s;
+}
+
+Window whole(const Header &h)
+{
+  return {0, h.rows(), 0, h.cols()};
+}
+
+int command_stats(const std::string &filename, const double chunk_mb)
+{
+  Snapshot snapshot(filename);
+  const Header &h = snapshot.header();
+  const Stats s = statistics(snapshot, whole(h), chunk_mb);
+  const double cell_area = h.Lx / (h.nx - 1) * (h.Ly / (h.ny - 1));
+
+  printf("%s: %llu x %llu %s, %s order, box %.2f x %.2f\n", filename.c_str(),
+         (unsigned long long)h.nx, (unsigned long long)h.ny, h.dtype == 1 ? "float32" : "float64",
+         h.layout == 1 ? "Fortran" : "C", h.Lx, h.Ly);
+  printf("  mean %+.6e  min %+.6e  max %+.6e  L2 %.6e  heat %+.6e\n",
+         s.sum / s.count, s.min, s.max, std::sqrt(s.sum2 * cell_area), s.sum * cell_area);
+  return 0;
+}
+
+int command_diff(const std::string &name_a, const std::string &name_b, const double chunk_mb)
+{
+  Snapshot a(name_a), b(name_b);
+  const Header &ha = a.header(), &hb = b.header();
+  if (ha.nx != hb.nx || ha.ny != hb.ny) {
+    throw std::runtime_error("the grids have different sizes");
+  }
+  if (ha.layout != hb.layout) {
+    throw std::runtime_error("the files have different layouts");
+  }
+
+  const uint64_t cols = ha.cols();
+  const uint64_t nrow = chunk_rows(cols, chunk_mb / 2);
+  std::vector<double> da, db;
+  double max_diff = -1.0, sum2 = 0.0;
+  uint64_t max_at = 0;
+
+  for (uint64_t r = 0; r < ha.rows(); r += nrow) {
+    const uint64_t r1 = std::min(r + nrow, ha.rows());
+    a.read(r, r1, 0, cols, da);
+    b.read(r, r1, 0, cols, db);
+    const int64_t n = da.size();
+
+    double chunk_sum2 = 0.0;
+    #pragma omp parallel reduction(+:chunk_sum2)
+    {
+      // Largest difference and its position in each thread
+      double thread_max = -1.0;
+      int64_t thread_at = 0;
+      #pragma omp for nowait
+      for (int64_t k = 0; k < n; k++) {
+        const double d = std::fabs(da[k] - db[k]);
+        chunk_sum2 += d * d;
+        if (d > thread_max) {
+          thread_max = d;
+          thread_at = k;
+        }
+      }
+      #pragma omp critical
+      if (thread_max > max_diff || (thread_max == max_diff && r * cols + thread_at < max_at)) {
+        max_diff = thread_max;
+        max_at = r * cols + thread_at;
+      }
+    }
+    sum2 += chunk_sum2;
+  }
+
+  // Position in the grid
+  uint64_t i = max_at / cols, j = max_at % cols;
+  if (ha.layout == 1) {
+    std::swap(i, j);
+  }
+  printf("%s - %s: max |difference| %.6e at u[%llu,%llu], rms difference %.6e\n",
+         name_a.c_str(), name_b.c_str(), max_diff, (unsigned long long)i, (unsigned long long)j,
+         std::sqrt(sum2 / (ha.nx * ha.ny)));
+  return 0;
+}
+
+// Colour map PiYG_r of heat-plot.py, for t in [0, 1]
+std::array<uint8_t, 3> colour(double t)
+{
+  static const double piyg[11][3] = {
+    {0.557, 0.004, 0.322}, {0.773, 0.106, 0.490}, {0.871, 0.467, 0.682},
+    {0.945, 0.714, 0.855}, {0.992, 0.878, 0.937}, {0.969, 0.969, 0.969},
+    {0.902, 0.961, 0.816}, {0.722, 0.882, 0.525}, {0.498, 0.737, 0.255},
+    {0.302, 0.573, 0.129}, {0.153, 0.392, 0.098},
+  };
+  // Reversed
+  t = 10.0 * (1.0 - std::clamp(t, 0.0, 1.0));
+  const int k = std::min((int)t, 9);
+  const double f = t - k;
+  std::array<uint8_t, 3> rgb;
+  for (int c = 0; c < 3; c++) {
+    rgb[c] = (uint8_t)std::lround(255.0 * ((1.0 - f) * piyg[k][c] + f * piyg[k + 1][c]));
+  }
+  return rgb;
+}
+
+uint32_t crc32(const uint8_t *data, const size_t n, uint32_t crc = 0)
+{
+  static uint32_t table[256];
+  static bool initialized = false;
+  if (!initialized) {
+    for (uint32_t k = 0; k < 256; k++) {
+      uint32_t c = k;
+      for (int bit = 0; bit < 8; bit++) {
+        c = c & 1 ? 0xedb88320u ^ (c >> 1) : c >> 1;
+      }
+      table[k] = c;
+    }
+    initialized = true;
+  }
+  crc = ~crc;
+  for (size_t k = 0; k < n; k++) {
+    crc = table[(crc ^ data[k]) & 0xff] ^ (crc >> 8);
+  }
+  return ~crc;
+}
+
+void put32(std::vector<uint8_t> &out, const uint32_t value)
+{
+  for (int shift = 24; shift >= 0; shift -= 8) {
+    out.push_back((value >> shift) & 0xff);
+  }
+}
+
+void write_png_chunk(FILE *file, const char *type, const std::vector<uint8_t> &data)
+{
+  std::vector<uint8_t> chunk;
+  put32(chunk, data.size());
+  chunk.insert(chunk.end(), type, type + 4);
+  chunk.insert(chunk.end(), data.begin(), data.end());
+  put32(chunk, crc32(chunk.data() + 4, chunk.size() - 4));
+  std::fwrite(chunk.data(), 1, chunk.size(), file);
+}
+
+// RGB image as PNG, with the data in stored (uncompressed) deflate blocks
+void write_png(FILE *file, const std::vector<uint8_t> &rgb, const uint32_t width, const uint32_t height)
+{
+  static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+  std::fwrite(signature, 1, 8, file);
+
+  std::vector<uint8_t> ihdr;
+  put32(ihdr, width);
+  put32(ihdr, height);
+  // 8 bits per channel, RGB, default compression, filter and no interlace
+  ihdr.insert(ihdr.end(), {8, 2, 0, 0, 0});
+  write_png_chunk(file, "IHDR", ihdr);
+
+  // Each row starts with filter type 0
+  std::vector<uint8_t> raw;
+  raw.reserve(height * (3 * width + 1));
+  for (uint32_t row = 0; row < height; row++) {
+    raw.push_back(0);
+    raw.insert(raw.end(), rgb.begin() + row * 3 * width, rgb.begin() + (row + 1) * 3 * width);
+  }
+
+  std::vector<uint8_t> zlib = {0x78, 0x01};
+  for (size_t offset = 0; offset < raw.size() || offset == 0; offset += 65535) {
+    const uint16_t len = std::min<size_t>(65535, raw.size() - offset);
+    zlib.push_back(offset + len >= raw.size() ? 1 : 0);
+    zlib.insert(zlib.end(), {(uint8_t)(len & 0xff), (uint8_t)(len >> 8),
+                             (uint8_t)(~len & 0xff), (uint8_t)((uint16_t)~len >> 8)});
+    zlib.insert(zlib.end(), raw.begin() + offset, raw.begin() + offset + len);
+  }
+  uint32_t s1 = 1, s2 = 0;
+  for (const uint8_t byte : raw) {
+    s1 = (s1 + byte) % 65521;
+    s2 = (s2 + s1) % 65521;
+  }
+  put32(zlib, (s2 << 16) | s1);
+  write_png_chunk(file, "IDAT", zlib);
+  write_png_chunk(file, "IEND", {});
+}
+
+void write_image(const std::string &filename, const std::vector<uint8_t> &rgb,
+                 const uint32_t width, const uint32_t height)
+{
+  FILE *file = std::fopen(filename.c_str(), "wb");
+  if (file == nullptr) {
+    throw std::runtime_error("cannot open " + filename);
+  }
+  const bool png = filename.size() >= 4 && filename.compare(filename.size() - 4, 4, ".png") == 0;
+  if (png) {
+    write_png(file, rgb, width, height);
+  } else {
+    std::fprintf(file, "P6\n%u %u\n255\n", width, height);
+    std::fwrite(rgb.data(), 1, rgb.size(), file);
+  }
+  std::fclose(file);
+}
+
+// Draw the window w of the stored data, averaged down to at most max_width
+// pixels per side, with the colour scale [-vmax, vmax]
+void render(Snapshot &snapshot, const Window &w, const uint64_t max_width, const double vmax,
+            const double chunk_mb, const std::string &filename)
+{
+  const Header &h = snapshot.header();
+  const uint64_t stride = std::max<uint64_t>(
+      1, (std::max(w.r1 - w.r0, w.c1 - w.c0) + max_width - 1) / max_width);
+  const int64_t height = (w.r1 - w.r0 + stride - 1) / stride;
+  const int64_t width = (w.c1 - w.c0 + stride - 1) / stride;
+
+  // Block averages in the stored orientation, one band of stride rows at a
+  // time, read in blocks of whole pixel columns within the chunk size (at
+  // least one pixel column per block)
+  const int64_t block = std::max<int64_t>(1, chunk_rows(stride, chunk_mb) / stride);
+  std::vector<double> image(height * width), band;
+  for (int64_t row = 0; row < height; row++) {
+    const uint64_t r0 = w.r0 + row * stride, r1 = std::min(r0 + stride, w.r1);
+    for (int64_t col0 = 0; col0 < width; col0 += block) {
+      const int64_t col1 = std::min(col0 + block, width);
+      const uint64_t b0 = w.c0 + col0 * stride, b1 = std::min(w.c0 + col1 * stride, w.c1);
+      snapshot.read(r0, r1, b0, b1, band);
+      const int64_t band_width = b1 - b0;
+      #pragma omp parallel for
+      for (int64_t col = col0; col < col1; col++) {
+        const int64_t c0 = (col - col0) * stride, c1 = std::min<int64_t>(c0 + stride, band_width);
+        double sum = 0.0;
+        for (uint64_t r = 0; r < r1 - r0; r++) {
+          for (int64_t c = c0; c < c1; c++) {
+            sum += band[r * band_width + c];
+          }
+        }
+        image[row * width + col] = sum / ((r1 - r0) * (c1 - c0));
+      }
+    }
+  }
+
+  // Pixels with the grid rows i upwards and the columns j to the right
+  const bool transpose = h.layout == 1;
+  const int64_t ni = transpose ? width : height;
+  const int64_t nj = transpose ? height : width;
+  std::vector<uint8_t> rgb(3 * ni * nj);
+  const double scale = vmax > 0.0 ? 0.5 / vmax : 0.0;
+  #pragma omp parallel for
+  for (int64_t i = 0; i < ni; i++) {
+    for (int64_t j = 0; j < nj; j++) {
+      const double value = transpose ? image[j * width + i] : image[i * width + j];
+      const auto c = colour(0.5 + value * scale);
+      std::copy(c.begin(), c.end(), rgb.begin() + 3 * ((ni - 1 - i) * nj + j));
+    }
+  }
+  write_image(filename, rgb, nj, ni);
+  printf("%s: %lld x %lld pixels, %llu x %llu grid points per pixel\n", filename.c_str(),
+         (long long)nj, (long long)ni, (unsigned long long)stride, (unsigned long long)stride);
+}
+
+int command_image(const std::string &input, const std::string &output, const uint64_t max_width,
+                  const std::string &window, const int ntile, const double chunk_mb)
+{
+  Snapshot snapshot(input);
+  const Header &h = snapshot.header();
+
+  // Window in grid rows i and columns j
+  uint64_t i0 = 0, i1 = h.ny, j0 = 0, j1 = h.nx;
+  if (!window.empty()) {
+    unsigned long long a, b, c, d;
+    if (std::sscanf(window.c_str(), "%llu:%llu,%llu:%llu", &a, &b, &c, &d) != 4
+        || a >= b || b > h.ny || c >= d || d > h.nx) {
+      throw std::runtime_error("invalid window " + window);
+    }
+    i0 = a; i1 = b; j0 = c; j1 = d;
+  }
+  const Window w = h.layout == 1 ? Window{j0, j1, i0, i1} : Window{i0, i1, j0, j1};
+
+  // Same colour scale for all tiles, symmetric as in heat-plot.py
+  const Stats s = statistics(snapshot, w, chunk_mb);
+  const double vmax = std::max(s.max, -s.min);
+
+  if (ntile == 1) {
+    render(snapshot, w, max_width, vmax, chunk_mb, output);
+    return 0;
+  }
+
+  const size_t dot = output.rfind('.');
+  const std::string stem = output.substr(0, dot);
+  const std::string ext = dot == std::string::npos ? "" : output.substr(dot);
+  for (int ti = 0; ti < ntile; ti++) {
+    for (int tj = 0; tj < ntile; tj++) {
+      const uint64_t ti0 = i0 + (i1 - i0) * ti / ntile, ti1 = i0 + (i1 - i0) * (ti + 1) / ntile;
+      const uint64_t tj0 = j0 + (j1 - j0) * tj / ntile, tj1 = j0 + (j1 - j0) * (tj + 1) / ntile;
+      const Window t = h.layout == 1 ? Window{tj0, tj1, ti0, ti1} : Window{ti0, ti1, tj0, tj1};
+      render(snapshot, t, max_width, vmax, chunk_mb,
+             stem + "_" + std::to_string(ti) + "_" + std::to_string(tj) + ext);
+    }
+  }
+  return 0;
+}
+
+void usage()
+{
+  printf("Usage: heat-post stats <file>\n"
+         "       heat-post diff <file a> <file b>\n"
+         "       heat-post image <file> <output.png|output.ppm> [--width pixels]\n"
+         "                 [--window i0:i1,j0:j1] [--tiles n]\n"
+         "Options for all commands: [--chunk-mb size]\n");
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+  std::vector<std::string> args;
+  uint64_t width = 1024;
+  std::string window;
+  int ntile = 1;
+  double chunk_mb = 64.0;
+
+  for (int k = 1; k < argc; k++) {
+    const std::string arg = argv[k];
+    if (k + 1 < argc && arg == "--width") {
+      width = std::strtoull(argv[++k], nullptr, 10);
+    } else if (k + 1 < argc && arg == "--window") {
+      window = argv[++k];
+    } else if (k + 1 < argc && arg == "--tiles") {
+      ntile = std::atoi(argv[++k]);
+    } else if (k + 1 < argc && arg == "--chunk-mb") {
+      chunk_mb = std::atof(argv[++k]);
+    } else {
+      args.push_back(arg);
+    }
+  }
+  if (width < 1 || ntile < 1 || chunk_mb <= 0.0) {
+    usage();
+    return 1;
+  }
+
+  try {
+    if (args.size() == 2 && args[0] == "stats") {
+      return command_stats(args[1], chunk_mb);
+    }
+    if (args.size() == 3 && args[0] == "diff") {
+      return command_diff(args[1], args[2], chunk_mb);
+    }
+    if (args.size() == 3 && args[0] == "image") {
+      return command_image(args[1], args[2], width, window, ntile, chunk_mb);
+    }
+  } catch (const std::exception &e) {
+    fprintf(stderr, "heat-post: %s\n", e.what());
+    return 1;
+  }
+
+  usage();
+  return 1;
+}
@@ -8,7 +8,11 @@
 #include <math.h>
 
 #if defined(TRACE)
-  #if defined(__NVCOMPILER) || defined(__CUDACC__)
+  #if defined(TRACE_CPU)
+    #include "trace_cpu.h"
+    #define TRACE_PUSH(name) trace_cpu_push(name)
+    #define TRACE_POP()      trace_cpu_pop()
+  #elif defined(__NVCOMPILER) || defined(__CUDACC__)
     #include <nvtx3/nvToolsExt.h>
     #define TRACE_PUSH(name) nvtxRangePushA(name)
     #define TRACE_POP()      nvtxRangePop()
@@ -48,18 +52,15 @@ void create_input(double *u, const int nx, const int ny, const double Lx, const
 }
 
 
-static
-int write_array(const char *filename, const double *array, const size_t nx, const size_t ny, const double Lx, const double Ly)
-{
-    TRACE_PUSH(__func__);
+// Element types of the array data in the binary files
+enum { HEAT_DTYPE_FLOAT64 = 0, HEAT_DTYPE_FLOAT32 = 1 };
 
-    FILE *file = fopen(filename, "wb");
-    if (file == NULL) {
-        perror("Failed to open file");
-        TRACE_POP();
-        return 1;
-    }
 
+// Header of the binary files, followed by the array data
+static
+void write_array_header(FILE *file, const unsigned char dtype,
+                        const size_t nx, const size_t ny, const double Lx, const double Ly)
+{
     // Write the box size
     fwrite(&Lx, sizeof(double), 1, file);
     fwrite(&Ly, sizeof(double), 1, file);
@@ -72,9 +73,31 @@ int write_array(const char *filename, const double *array, const size_t nx, cons
     const unsigned char layout = 0;
     fwrite(&layout, 1, 1, file);
 
+    // Write the element type (0 = float64, 1 = float32)
+    fwrite(&dtype, 1, 1, file);
+}
+
+
+static
+int write_array_dtype(const char *filename, const void *array, const unsigned char dtype,
+                      const size_t nx, const size_t ny, const double Lx, const double Ly)
+{
+    // Same range name for both element types, as referred to in the exercises
+    TRACE_PUSH("write_array");
+
+    FILE *file = fopen(filename, "wb");
+    if (file == NULL) {
+        perror("Failed to open file");
+        TRACE_POP();
+        return 1;
+    }
+
+    write_array_header(file, dtype, nx, ny, Lx, Ly);
+
     // Write the array data
     const size_t count = nx * ny;
-    size_t written = fwrite(array, sizeof(double), count, file);
+    const size_t size = dtype == HEAT_DTYPE_FLOAT32 ? sizeof(float) : sizeof(double);
+    size_t written = fwrite(array, size, count, file);
 
     fclose(file);
 
@@ -88,3 +111,10 @@ int write_array(const char *filename, const double *array, const size_t nx, cons
 
     return 0;
 }
+
+
+static
+int write_array(const char *filename, const double *array, const size_t nx, const size_t ny, const double Lx, const double Ly)
+{
+    return write_array_dtype(filename, array, HEAT_DTYPE_FLOAT64, nx, ny, Lx, Ly);
+}
@@ -0,0 +1,384 @@
+/*
+ * SPDX-FileCopyrightText: 2026 CSC - IT Center for Science Ltd. <www.csc.fi>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/*
+ * Average temperature over any number of monitoring regions
+ *
+ * Regions are registered once at startup, either as rectangles or as
+ * masks of grid points:
+ *
+ *     heat_regions_t regions;
+ *     heat_regions_init(&regions, nx, ny);
+ *     heat_regions_add_rect(&regions, "left half", 0, ny, 0, nx / 2);
+ *     heat_regions_add_mask(&regions, "disc", mask);
+ *     heat_regions_map(&regions);          // copy the regions to the device
+ *     ...
+ *     heat_regions_compute(&regions, u);   // u must be present on the device
+ *     heat_regions_print(&regions, it, 8);
+ *     ...
+ *     heat_regions_free(&regions);
+ *
+ * The cost does not grow with the number of regions:
+ * - For the rectangles, a summed-area table S(i, j) = sum of u[0:i, 0:j] is
+ *   built with one pass over the rows and one over the columns, after which
+ *   the sum over any rectangle takes four lookups. The rectangles may overlap.
+ *   The row pass is a parallel scan within each row (an inscan reduction),
+ *   and the column pass runs one thread per column, so neighbouring threads
+ *   access neighbouring elements in both.
+ * - For the masks, heat_regions_map() lists the masked grid points sorted by
+ *   mask and splits the list into segments of at most
+ *   HEAT_REGION_SEGMENT points of one mask. A single kernel sums each
+ *   segment in one team and adds it to the sum of its mask with one atomic
+ *   update, so the cost grows with the number of masked points and not with
+ *   the number of masks, and there are few atomic updates per mask. A grid
+ *   point can belong to only one mask.
+ *
+ * Note that the table sums become large compared to the sums of small
+ * rectangles, so their rounding errors are relative to the whole grid.
+ */
+
+#ifndef HEAT_REGIONS_H
+#define HEAT_REGIONS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define HEAT_REGION_NAME_LEN 32
+#define HEAT_REGION_SEGMENT 4096
+
+typedef struct {
+    int nx, ny;
+
+    // Rectangles i0 <= i < i1, j0 <= j < j1, four ints per rectangle
+    int nrect;
+    int *rect;
+
+    // Mask label of each grid point, -1 if none
+    int nmask;
+    int *label;
+
+    // Masked grid points sorted by mask, in nseg segments of one mask each:
+    // segment g is point[seg_begin[g]:seg_begin[g+1]] of mask seg_mask[g]
+    long npoint;
+    int *point;
+    int nseg;
+    long *seg_begin;
+    int *seg_mask;
+
+    int nregion;
+    char (*name)[HEAT_REGION_NAME_LEN];
+    long *count;     // number of grid points per region
+    double *sum;     // sums per region, rectangles first
+
+    double *table;   // summed-area table, (ny + 1) x (nx + 1)
+    int mapped;
+} heat_regions_t;
+
+
+static
+void heat_regions_init(heat_regions_t *r, const int nx, const int ny)
+{
+    memset(r, 0, sizeof(*r));
+    r->nx = nx;
+    r->ny = ny;
+}
+
+
+// Add a region to the name, count and sum arrays and return its index
+static
+int heat_regions_append(heat_regions_t *r, const char *name, const long count)
+{
+    if (r->mapped) {
+        fprintf(stderr, "heat_regions: cannot add region '%s' after heat_regions_map\n", name);
+        return -1;
+    }
+    const int k = r->nregion++;
+    r->name = realloc(r->name, r->nregion * sizeof(*r->name));
+    r->count = realloc(r->count, r->nregion * sizeof(long));
+    r->sum = realloc(r->sum, r->nregion * sizeof(double));
+    snprintf(r->name[k], HEAT_REGION_NAME_LEN, "%s", name);
+    r->count[k] = count;
+    r->sum[k] = 0.0;
+    return k;
+}
+
+
+// Rectangle i0 <= i < i1, j0 <= j < j1. Returns the region index, or -1 on error.
+static
+int heat_regions_add_rect(heat_regions_t *r, const char *name,
+                          const int i0, const int i1, const int j0, const int j1)
+{
+    if (i0 < 0 || i1 > r->ny || i0 >= i1 || j0 < 0 || j1 > r->nx || j0 >= j1) {
+        fprintf(stderr, "heat_regions: invalid rectangle '%s'\n", name);
+        return -1;
+    }
+    // The rectangles come first in the sums, so they can only be added
+    // before the masks
+    if (r->nmask > 0) {
+        fprintf(stderr, "heat_regions: add rectangle '%s' before the masks\n", name);
+        return -1;
+    }
+    const int k = heat_regions_append(r, name, (long)(i1 - i0) * (j1 - j0));
+    if (k < 0) {
+        return -1;
+    }
+    r->rect = realloc(r->rect, 4 * (r->nrect + 1) * sizeof(int));
+    int *b = &r->rect[4 * r->nrect];
+    b[0] = i0; b[1] = i1; b[2] = j0; b[3] = j1;
+    r->nrect++;
+    return k;
+}
+
+
+// Grid points with mask[i * nx + j] != 0. Returns the region index, or -1
+// on error (e.g. if the mask overlaps a previous one).
+static
+int heat_regions_add_mask(heat_regions_t *r, const char *name, const unsigned char *mask)
+{
+    const size_t n2 = (size_t)r->nx * r->ny;
+    if (r->label == NULL) {
+        r->label = malloc(n2 * sizeof(int));
+        for (size_t ij = 0; ij < n2; ij++) {
+            r->label[ij] = -1;
+        }
+    }
+
+    long count = 0;
+    for (size_t ij = 0; ij < n2; ij++) {
+        if (mask[ij] && r->label[ij] >= 0) {
+            fprintf(stderr, "heat_regions: mask '%s' overlaps mask %d\n", name, r->label[ij]);
+            return -1;
+        }
+        count += mask[ij] != 0;
+    }
+
+    const int k = heat_regions_append(r, name, count);
+    if (k < 0) {
+        return -1;
+    }
+    for (size_t ij = 0; ij < n2; ij++) {
+        if (mask[ij]) {
+            r->label[ij] = r->nmask;
+        }
+    }
+    r->nmask++;
+    return k;
+}
+
+
+// List the masked grid points by mask and split them into segments
+static
+void heat_regions_segment(heat_regions_t *r)
+{
+    const size_t n2 = (size_t)r->nx * r->ny;
+    const int nmask = r->nmask, nrect = r->nrect;
+
+    // Start of each mask in the sorted list (counting sort by label)
+    long *start = calloc(nmask + 1, sizeof(long));
+    for (int l = 0; l < nmask; l++) {
+        start[l + 1] = start[l] + r->count[nrect + l];
+    }
+    r->npoint = start[nmask];
+    r->point = malloc((r->npoint > 0 ? r->npoint : 1) * sizeof(int));
+    long *next = malloc((nmask > 0 ? nmask : 1) * sizeof(long));
+    memcpy(next, start, nmask * sizeof(long));
+    for (size_t ij = 0; ij < n2; ij++) {
+        if (r->label[ij] >= 0) {
+            r->point[next[r->label[ij]]++] = (int)ij;
+        }
+    }
+
+    r->nseg = 0;
+    for (int l = 0; l < nmask; l++) {
+        r->nseg += (int)((r->count[nrect + l] + HEAT_REGION_SEGMENT - 1) / HEAT_REGION_SEGMENT);
+    }
+    r->seg_begin = malloc((r->nseg + 1) * sizeof(long));
+    r->seg_mask = malloc((r->nseg > 0 ? r->nseg : 1) * sizeof(int));
+    int g = 0;
+    for (int l = 0; l < nmask; l++) {
+        for (long p = start[l]; p < start[l + 1]; p += HEAT_REGION_SEGMENT) {
+            r->seg_begin[g] = p;
+            r->seg_mask[g] = l;
+            g++;
+        }
+    }
+    r->seg_begin[r->nseg] = r->npoint;
+
+    free(next);
+    free(start);
+}
+
+
+// Copy the regions to the device, after all regions have been added
+static
+void heat_regions_map(heat_regions_t *r)
+{
+    const int nx = r->nx, ny = r->ny;
+    const int nrect = r->nrect, nregion = r->nregion;
+    double *table = malloc((size_t)(nx + 1) * (ny + 1) * sizeof(double));
+    double *sum = r->sum;
+    int *rect = r->rect, *label = r->label;
+
+    if (label != NULL) {
+        heat_regions_segment(r);
+    }
+    const long npoint = r->npoint;
+    const int nseg = r->nseg;
+    int *point = r->point, *seg_mask = r->seg_mask;
+    long *seg_begin = r->seg_begin;
+    // (used only in map clauses, which some compilers do not count as a use)
+    (void)point; (void)seg_mask; (void)seg_begin;
+
+    #pragma omp target enter data map(alloc: table[0:(nx+1)*(ny+1)])
+    if (sum != NULL) {
+        #pragma omp target enter data map(alloc: sum[0:nregion])
+    }
+    if (rect != NULL) {
+        #pragma omp target enter data map(to: rect[0:4*nrect])
+    }
+    if (label != NULL) {
+        #pragma omp target enter data map(to: label[0:nx*ny])
+        #pragma omp target enter data map(to: point[0:npoint], seg_begin[0:nseg+1], seg_mask[0:nseg])
+    }
+    r->table = table;
+    r->mapped = 1;
+}
+
+
+// Sums over all regions in a fixed number of kernels
+static
+void heat_regions_compute(heat_regions_t *r, const double *u)
+{
+    const int nx = r->nx, ny = r->ny;
+    const int nx1 = nx + 1;
+    const int nrect = r->nrect, nregion = r->nregion;
+    double *table = r->table, *sum = r->sum;
+    int *rect = r->rect, *label = r->label;
+    const int nseg = r->nseg;
+    int *point = r->point, *seg_mask = r->seg_mask;
+    long *seg_begin = r->seg_begin;
+
+    if (nrect > 0) {
+        // Prefix sums along the rows, with a zero first row and column. One
+        // team scans each row.
+        #pragma omp target teams distribute
+        for (int i = 0; i <= ny; i++) {
+            double s = 0.0;
+            table[i * nx1] = 0.0;
+            #pragma omp parallel for reduction(inscan, +: s)
+            for (int j = 0; j < nx; j++) {
+                s += i > 0 ? u[(i - 1) * nx + j] : 0.0;
+                #pragma omp scan inclusive(s)
+                table[i * nx1 + j + 1] = s;
+            }
+        }
+
+        // Prefix sums along the columns, one thread per column
+        #pragma omp target teams distribute parallel for
+        for (int j = 0; j <= nx; j++) {
+            for (int i = 1; i <= ny; i++) {
+                table[i * nx1 + j] += table[(i - 1) * nx1 + j];
+            }
+        }
+
+        // Sum of each rectangle from its four corners
+        #pragma omp target teams distribute parallel for
+        for (int k = 0; k < nrect; k++) {
+            const int i0 = rect[4 * k], i1 = rect[4 * k + 1];
+            const int j0 = rect[4 * k + 2], j1 = rect[4 * k + 3];
+            sum[k] = table[i1 * nx1 + j1] - table[i0 * nx1 + j1]
+                   - table[i1 * nx1 + j0] + table[i0 * nx1 + j0];
+        }
+    }
+
+    if (label != NULL) {
+        #pragma omp target teams distribute parallel for
+        for (int k = nrect; k < nregion; k++) {
+            sum[k] = 0.0;
+        }
+
+        // One team per segment, one atomic update per segment
+        #pragma omp target teams distribute
+        for (int g = 0; g < nseg; g++) {
+            double s = 0.0;
+            #pragma omp parallel for reduction(+: s)
+            for (long p = seg_begin[g]; p < seg_begin[g + 1]; p++) {
+                s += u[point[p]];
+            }
+            #pragma omp atomic update
+            sum[nrect + seg_mask[g]] += s;
+        }
+    }
+
+    #pragma omp target update from(sum[0:nregion])
+}
+
+
+static
+double heat_regions_average(const heat_regions_t *r, const int k)
+{
+    return r->count[k] > 0 ? r->sum[k] / r->count[k] : 0.0;
+}
+
+
+// Print the averages of the first max_print regions on one line
+static
+void heat_regions_print(const heat_regions_t *r, const int it, const int max_print)
+{
+    printf("%06d:", it);
+    for (int k = 0; k < r->nregion && k < max_print; k++) {
+        printf("  %+9.4f", heat_regions_average(r, k));
+    }
+    if (r->nregion > max_print) {
+        printf("  (+%d regions)", r->nregion - max_print);
+    }
+    printf("\n");
+}
+
+
+static
+void heat_regions_free(heat_regions_t *r)
+{
+    const int nx = r->nx, ny = r->ny;
+    const int nrect = r->nrect, nregion = r->nregion;
+    double *table = r->table, *sum = r->sum;
+    int *rect = r->rect, *label = r->label;
+    const long npoint = r->npoint;
+    const int nseg = r->nseg;
+    int *point = r->point, *seg_mask = r->seg_mask;
+    long *seg_begin = r->seg_begin;
+    // (used only in map clauses, which some compilers do not count as a use)
+    (void)point; (void)seg_mask; (void)seg_begin;
+
+    if (r->mapped) {
+        if (table != NULL) {
+            #pragma omp target exit data map(delete: table[0:(nx+1)*(ny+1)])
+        }
+        if (sum != NULL) {
+            #pragma omp target exit data map(delete: sum[0:nregion])
+        }
+        if (rect != NULL) {
+            #pragma omp target exit data map(delete: rect[0:4*nrect])
+        }
+        if (label != NULL) {
+            #pragma omp target exit data map(delete: label[0:nx*ny])
+            #pragma omp target exit data map(delete: point[0:npoint], seg_begin[0:nseg+1], seg_mask[0:nseg])
+        }
+    }
+    free(r->table);
+    free(r->rect);
+    free(r->label);
+    free(r->point);
+    free(r->seg_begin);
+    free(r->seg_mask);
+    free(r->name);
+    free(r->count);
+    free(r->sum);
+    memset(r, 0, sizeof(*r));
+}
+
+#endif
@@ -0,0 +1,245 @@
+/*
+ * SPDX-FileCopyrightText: 2026 CSC - IT Center for Science Ltd. <www.csc.fi>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/*
+ * Writing device arrays to files through pinned host staging buffers
+ *
+ * Instead of a `target update` of the whole array into pageable memory, the
+ * array is first copied to a snapshot buffer on the device, and the snapshot
+ * is copied to the host in chunks through a few staging buffers allocated
+ * with a pinned allocator. Each chunk is written to the file while the next
+ * one is being copied:
+ *
+ *     heat_staging_t staging;
+ *     heat_staging_init(&staging, chunk_bytes);
+ *     ...
+ *     #pragma omp target data use_device_ptr(u)
+ *     heat_staging_write(&staging, filename, u_host, u, nx, ny, Lx, Ly);
+ *     ...
+ *     #pragma omp taskwait
+ *     heat_staging_print(&staging);
+ *     heat_staging_free(&staging);
+ *
+ * heat_staging_write() only creates tasks, so it has to be called inside a
+ * parallel region with enough threads to run the copies and the writing
+ * next to the thread launching the kernels. Only the device-to-device copy
+ * into the snapshot buffer depends on the host address of the array
+ * (depend(in: u_host[0:nx*ny])), so the kernels writing to the array with
+ * depend(out: ...) wait for that copy, but not for the chunks to be copied
+ * to the host or written. The staging copies depend on the snapshot buffer
+ * instead. The snapshot buffer costs a second copy of the array in device
+ * memory, and the next snapshot waits until the previous one has been
+ * copied to the host. Snapshots are written one at a time.
+ *
+ * If pinned memory is not available, the buffers are allocated with the
+ * default allocator. Without a device, the copies are host to host, so the
+ * code can be tested on the CPU.
+ */
+
+#ifndef HEAT_STAGING_H
+#define HEAT_STAGING_H
+
+#include <stdio.h>
+#include <string.h>
+#include <omp.h>
+
+#define HEAT_STAGING_NBUF 2
+
+typedef struct {
+    size_t chunk;                     // chunk size in elements
+    double *buf[HEAT_STAGING_NBUF];
+    omp_allocator_handle_t allocator;
+    int pinned;                       // whether the buffers are pinned
+    int device, host;
+
+    double *snap;                     // snapshot of the array on the device
+    size_t snap_size;                 // size of the snapshot in elements
+
+    FILE *file;                       // snapshot being written
+    int error;                        // nonzero if writing a snapshot failed
+    char snap_flag;                   // dependency object of the snapshot
+    char buf_flag[HEAT_STAGING_NBUF]; // dependency objects of the buffers
+    char file_flag;                   // dependency object of the file
+
+    // Bytes and busy time of each stage
+    double bytes_copied, time_copy;
+    double bytes_written, time_write;
+    int nfile;
+} heat_staging_t;
+
+
+static
+void heat_staging_init(heat_staging_t *s, const size_t chunk_bytes)
+{
+    memset(s, 0, sizeof(*s));
+    s->chunk = chunk_bytes / sizeof(double) > 0 ? chunk_bytes / sizeof(double) : 1;
+    s->host = omp_get_initial_device();
+    s->device = omp_get_num_devices() > 0 ? omp_get_default_device() : s->host;
+
+    // Pinned memory if available, without falling back silently
+    omp_alloctrait_t traits[] = {{omp_atk_pinned, omp_atv_true},
+                                 {omp_atk_fallback, omp_atv_null_fb}};
+    s->allocator = omp_init_allocator(omp_default_mem_space, 2, traits);
+    s->pinned = s->allocator != omp_null_allocator;
+    for (int b = 0; b < HEAT_STAGING_NBUF && s->pinned; b++) {
+        s->buf[b] = (double*)omp_alloc(s->chunk * sizeof(double), s->allocator);
+        s->pinned = s->buf[b] != NULL;
+    }
+
+    if (!s->pinned) {
+        for (int b = 0; b < HEAT_STAGING_NBUF; b++) {
+            if (s->buf[b] != NULL) {
+                omp_free(s->buf[b], s->allocator);
+            }
+        }
+        if (s->allocator != omp_null_allocator) {
+            omp_destroy_allocator(s->allocator);
+        }
+        s->allocator = omp_default_mem_alloc;
+        for (int b = 0; b < HEAT_STAGING_NBUF; b++) {
+            s->buf[b] = (double*)omp_alloc(s->chunk * sizeof(double), s->allocator);
+        }
+    }
+}
+
+
+// Create the tasks writing the device array u_dev (with host address u_host)
+// to a file
+static
+void heat_staging_write(heat_staging_t *s, const char *filename,
+                        const double *u_host, const double *u_dev,
+                        const size_t nx, const size_t ny, const double Lx, const double Ly)
+{
+    const size_t n2 = nx * ny;
+    const size_t nchunk = (n2 + s->chunk - 1) / s->chunk;
+
+    // (u_host is used only in a depend clause, which some compilers do not
+    // count as a use.)
+    (void)u_host;
+
+    // The snapshot buffer is allocated for the first array and reused, after
+    // the previous snapshot has been copied from it
+    if (s->snap_size != n2) {
+        if (s->snap != NULL) {
+            #pragma omp taskwait
+            omp_target_free(s->snap, s->device);
+        }
+        s->snap = (double*)omp_target_alloc(n2 * sizeof(double), s->device);
+        s->snap_size = n2;
+    }
+
+    char name[256];
+    snprintf(name, sizeof(name), "%s", filename);
+
+    #pragma omp task firstprivate(s, name, nx, ny, Lx, Ly) depend(inout: s->file_flag)
+    {
+        s->file = fopen(name, "wb");
+        if (s->file == NULL) {
+            perror("Failed to open file");
+            s->error = 1;
+        } else {
+            write_array_header(s->file, HEAT_DTYPE_FLOAT64, nx, ny, Lx, Ly);
+        }
+    }
+
+    // Snapshot of the array on the device, once the array is ready and the
+    // previous snapshot has been copied to the host
+    #pragma omp task firstprivate(s, u_dev, n2) depend(in: u_host[0:n2]) depend(inout: s->snap_flag)
+    {
+        TRACE_PUSH("staging snapshot");
+        if (omp_target_memcpy(s->snap, u_dev, n2 * sizeof(double), 0, 0, s->device, s->device) != 0) {
+            fprintf(stderr, "heat_staging: omp_target_memcpy failed\n");
+            s->error = 1;
+        }
+        TRACE_POP();
+    }
+
+    for (size_t k = 0; k < nchunk; k++) {
+        const int b = k % HEAT_STAGING_NBUF;
+        const size_t offset = k * s->chunk;
+        const size_t count = offset + s->chunk <= n2 ? s->chunk : n2 - offset;
+
+        // Copy a chunk of the snapshot from the device, once the previous
+        // contents of the buffer have been written
+        #pragma omp task firstprivate(s, b, offset, count) depend(in: s->snap_flag) depend(inout: s->buf_flag[b])
+        {
+            TRACE_PUSH("staging copy");
+            double t0 = omp_get_wtime();
+            if (omp_target_memcpy(s->buf[b], s->snap, count * sizeof(double), 0,
+                                  offset * sizeof(double), s->host, s->device) != 0) {
+                fprintf(stderr, "heat_staging: omp_target_memcpy failed\n");
+                s->error = 1;
+            }
+            double t1 = omp_get_wtime();
+            #pragma omp atomic update
+            s->time_copy += t1 - t0;
+            #pragma omp atomic update
+            s->bytes_copied += count * sizeof(double);
+            TRACE_POP();
+        }
+
+        // Write the chunk, in order, while the next one is being copied
+        #pragma omp task firstprivate(s, b, count) depend(inout: s->buf_flag[b]) depend(inout: s->file_flag)
+        {
+            TRACE_PUSH("staging write");
+            double t0 = omp_get_wtime();
+            if (s->file != NULL && fwrite(s->buf[b], sizeof(double), count, s->file) != count) {
+                fprintf(stderr, "Failed to write all elements to file\n");
+                s->error = 1;
+            }
+            double t1 = omp_get_wtime();
+            #pragma omp atomic update
+            s->time_write += t1 - t0;
+            #pragma omp atomic update
+            s->bytes_written += count * sizeof(double);
+            TRACE_POP();
+        }
+    }
+
+    #pragma omp task firstprivate(s) depend(inout: s->file_flag)
+    {
+        if (s->file != NULL) {
+            fclose(s->file);
+            s->file = NULL;
+        }
+        s->nfile++;
+    }
+}
+
+
+// Throughput of each stage, over the time spent in it
+static
+void heat_staging_print(const heat_staging_t *s)
+{
+    printf("Staging: %d files through %d x %.1f MB %s buffers\n", s->nfile, HEAT_STAGING_NBUF,
+           1.0e-6 * s->chunk * sizeof(double), s->pinned ? "pinned" : "pageable");
+    if (s->time_copy > 0.0) {
+        printf("  device to host: %10.3f GB in %8.3f s = %8.2f GB/s\n",
+               1.0e-9 * s->bytes_copied, s->time_copy, 1.0e-9 * s->bytes_copied / s->time_copy);
+    }
+    if (s->time_write > 0.0) {
+        printf("  host to file:   %10.3f GB in %8.3f s = %8.2f GB/s\n",
+               1.0e-9 * s->bytes_written, s->time_write, 1.0e-9 * s->bytes_written / s->time_write);
+    }
+}
+
+
+static
+void heat_staging_free(heat_staging_t *s)
+{
+    for (int b = 0; b < HEAT_STAGING_NBUF; b++) {
+        omp_free(s->buf[b], s->allocator);
+    }
+    if (s->pinned) {
+        omp_destroy_allocator(s->allocator);
+    }
+    if (s->snap != NULL) {
+        omp_target_free(s->snap, s->device);
+    }
+    memset(s, 0, sizeof(*s));
+}
+
+#endif
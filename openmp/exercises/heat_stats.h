@@ -0,0 +1,122 @@
+/*
+ * SPDX-FileCopyrightText: 2026 CSC - IT Center for Science Ltd. <www.csc.fi>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/*
+ * Statistics of the temperature per quadrant, computed in a single pass
+ *
+ * All statistics of all four quadrants are collected into one struct
+ * with a user-defined reduction, so that one kernel reads u only once:
+ *
+ *     heat_stats_t stats = heat_stats_init();
+ *     #pragma omp target map(tofrom: stats)
+ *     #pragma omp teams distribute parallel for collapse(2) reduction(heat_stats:stats)
+ *     for (int i = 0; i < ny; i++) {
+ *         for (int j = 0; j < nx; j++) {
+ *             heat_stats_add(&stats, heat_quadrant(i, j, nx, ny), u[i * nx + j]);
+ *         }
+ *     }
+ *     heat_stats_print(it, &stats, dx, dy);
+ *
+ * The quadrants are numbered 0: i < ny/2, j < nx/2, 1: i < ny/2, j >= nx/2,
+ * 2: i >= ny/2, j < nx/2, and 3: i >= ny/2, j >= nx/2.
+ */
+
+#ifndef HEAT_STATS_H
+#define HEAT_STATS_H
+
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+
+#define HEAT_NQUADRANT 4
+
+typedef struct {
+    long count;
+    double sum;   // sum of u
+    double sum2;  // sum of u^2
+    double min;
+    double max;
+} heat_stat_t;
+
+typedef struct {
+    heat_stat_t q[HEAT_NQUADRANT];
+} heat_stats_t;
+
+#pragma omp declare target
+
+static inline
+heat_stats_t heat_stats_init(void)
+{
+    heat_stats_t stats;
+    for (int q = 0; q < HEAT_NQUADRANT; q++) {
+        stats.q[q].count = 0;
+        stats.q[q].sum = 0.0;
+        stats.q[q].sum2 = 0.0;
+        stats.q[q].min = DBL_MAX;
+        stats.q[q].max = -DBL_MAX;
+    }
+    return stats;
+}
+
+static inline
+int heat_quadrant(const int i, const int j, const int nx, const int ny)
+{
+    return 2 * (i >= ny / 2) + (j >= nx / 2);
+}
+
+static inline
+void heat_stats_add(heat_stats_t *stats, const int q, const double u)
+{
+    heat_stat_t *s = &stats->q[q];
+    s->count++;
+    s->sum += u;
+    s->sum2 += u * u;
+    s->min = fmin(s->min, u);
+    s->max = fmax(s->max, u);
+}
+
+static inline
+void heat_stats_combine(heat_stats_t *out, const heat_stats_t *in)
+{
+    for (int q = 0; q < HEAT_NQUADRANT; q++) {
+        out->q[q].count += in->q[q].count;
+        out->q[q].sum += in->q[q].sum;
+        out->q[q].sum2 += in->q[q].sum2;
+        out->q[q].min = fmin(out->q[q].min, in->q[q].min);
+        out->q[q].max = fmax(out->q[q].max, in->q[q].max);
+    }
+}
+
+#pragma omp end declare target
+
+#pragma omp declare reduction(heat_stats : heat_stats_t : heat_stats_combine(&omp_out, &omp_in)) \
+    initializer(omp_priv = heat_stats_init())
+
+/*
+ * Print the average temperature of each quadrant, followed by the minimum,
+ * maximum, L2 norm (sqrt of the integral of u^2) and total heat (integral
+ * of u) over the whole grid with grid spacing dx, dy
+ */
+static inline
+void heat_stats_print(const int it, const heat_stats_t *stats, const double dx, const double dy)
+{
+    heat_stat_t all = stats->q[0];
+    for (int q = 1; q < HEAT_NQUADRANT; q++) {
+        all.sum += stats->q[q].sum;
+        all.sum2 += stats->q[q].sum2;
+        all.min = fmin(all.min, stats->q[q].min);
+        all.max = fmax(all.max, stats->q[q].max);
+    }
+
+    printf("%06d:  %+9.4f  %+9.4f  %+9.4f  %+9.4f  min %+9.4f  max %+9.4f  L2 %9.4f  heat %+11.4e\n", it,
+           stats->q[0].sum / stats->q[0].count,
+           stats->q[1].sum / stats->q[1].count,
+           stats->q[2].sum / stats->q[2].count,
+           stats->q[3].sum / stats->q[3].count,
+           all.min, all.max, sqrt(all.sum2 * dx * dy), all.sum * dx * dy);
+}
+
+#endif
@@ -0,0 +1,133 @@
+/*
+ * SPDX-FileCopyrightText: 2026 CSC - IT Center for Science Ltd. <www.csc.fi>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/*
+ * Reduced outputs of the heat field computed on the device
+ *
+ * A view is a window of the grid sampled with a stride, e.g. the whole grid
+ * at 1/8 resolution for a preview or a small region at full resolution.
+ * Each output point is the average of the stride x stride block it covers.
+ * Only the view is transferred to the host and written:
+ *
+ *     heat_view_t preview, window;
+ *     heat_view_init(&preview, nx, ny, Lx, Ly, 0, ny, 0, nx, 8);
+ *     heat_view_init(&window, nx, ny, Lx, Ly, ny / 4, ny / 2, nx / 4, nx / 2, 1);
+ *     ...
+ *     heat_view_compute(&preview, u);   // u must be present on the device,
+ *                                       // waits for the kernels writing u
+ *     heat_view_write(&preview, "preview.bin");
+ *     ...
+ *     heat_view_free(&preview);
+ *
+ * The files have the same format as write_array(), with the box size of the
+ * view, so they can be plotted with heat-plot.py.
+ */
+
+#ifndef HEAT_VIEW_H
+#define HEAT_VIEW_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    int nx_full, ny_full;  // size of the grid
+    int i0, i1, j0, j1;    // window i0 <= i < i1, j0 <= j < j1
+    int stride;
+    int nx, ny;            // size of the view
+    double Lx, Ly;         // box size of the view
+    double *data;          // view on the host and the device
+    double bytes;          // bytes transferred so far
+} heat_view_t;
+
+
+// Returns 0 on success and 1 if the window or stride is invalid
+static
+int heat_view_init(heat_view_t *v, const int nx_full, const int ny_full,
+                   const double Lx_full, const double Ly_full,
+                   const int i0, const int i1, const int j0, const int j1, const int stride)
+{
+    memset(v, 0, sizeof(*v));
+    if (i0 < 0 || i1 > ny_full || i0 >= i1 || j0 < 0 || j1 > nx_full || j0 >= j1 || stride < 1) {
+        fprintf(stderr, "heat_view: invalid window or stride\n");
+        return 1;
+    }
+    v->nx_full = nx_full;
+    v->ny_full = ny_full;
+    v->i0 = i0;
+    v->i1 = i1;
+    v->j0 = j0;
+    v->j1 = j1;
+    v->stride = stride;
+    v->nx = (j1 - j0 + stride - 1) / stride;
+    v->ny = (i1 - i0 + stride - 1) / stride;
+
+    // The output points are stride grid spacings apart
+    const double dx = Lx_full / (nx_full - 1);
+    const double dy = Ly_full / (ny_full - 1);
+    v->Lx = (v->nx - 1) * stride * dx;
+    v->Ly = (v->ny - 1) * stride * dy;
+
+    const int n = v->nx * v->ny;
+    double *data = (double*)malloc(n * sizeof(double));
+    #pragma omp target enter data map(alloc: data[0:n])
+    v->data = data;
+    return 0;
+}
+
+
+// Compute the view on the device and copy it to the host. The kernel depends
+// on u[0:nx_full*ny_full], so it waits for `target nowait` kernels writing u
+// with depend(out: ...).
+static
+void heat_view_compute(heat_view_t *v, const double *u)
+{
+    const int nx_full = v->nx_full, ny_full = v->ny_full;
+    const int i0 = v->i0, i1 = v->i1, j0 = v->j0, j1 = v->j1;
+    const int s = v->stride, nx = v->nx, ny = v->ny;
+    double *data = v->data;
+
+    #pragma omp target teams distribute parallel for collapse(2) depend(in: u[0:nx_full*ny_full])
+    for (int I = 0; I < ny; I++) {
+        for (int J = 0; J < nx; J++) {
+            // The last block of a row or column may be narrower
+            const int ib = i0 + I * s, ie = ib + s < i1 ? ib + s : i1;
+            const int jb = j0 + J * s, je = jb + s < j1 ? jb + s : j1;
+            double sum = 0.0;
+            for (int i = ib; i < ie; i++) {
+                for (int j = jb; j < je; j++) {
+                    sum += u[i * nx_full + j];
+                }
+            }
+            data[I * nx + J] = sum / ((ie - ib) * (je - jb));
+        }
+    }
+
+    #pragma omp target update from(data[0:nx*ny])
+    v->bytes += (double)nx * ny * sizeof(double);
+}
+
+
+static
+int heat_view_write(const heat_view_t *v, const char *filename)
+{
+    return write_array(filename, v->data, v->nx, v->ny, v->Lx, v->Ly);
+}
+
+
+static
+void heat_view_free(heat_view_t *v)
+{
+    double *data = v->data;
+    const int n = v->nx * v->ny;
+    if (data != NULL) {
+        #pragma omp target exit data map(delete: data[0:n])
+    }
+    free(data);
+    memset(v, 0, sizeof(*v));
+}
+
+#endif
@@ -0,0 +1,139 @@
+/*
+ * SPDX-FileCopyrightText: 2026 CSC - IT Center for Science Ltd. <www.csc.fi>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/*
+ * Reproducible floating point sums
+ *
+ * Floating point addition is not associative, so the result of
+ * reduction(+:sum) depends on how the iterations are divided between
+ * threads and teams. Here each value is split into RSUM_FOLD parts that
+ * are rounded to fixed bins (pre-rounding): the parts of all values in
+ * the same bin are multiples of the same power of two and their sum
+ * cannot overflow the mantissa, so it is computed exactly in any order.
+ * The result is therefore bitwise identical for any number of threads,
+ * teams, or devices.
+ *
+ * The bins depend on the largest absolute value and the number of terms,
+ * so summation takes two passes:
+ *
+ *     double max_abs = 0.0;
+ *     #pragma omp parallel for reduction(max:max_abs)
+ *     for (int i = 0; i < n; i++)
+ *         max_abs = fmax(max_abs, fabs(x[i]));
+ *
+ *     rsum_bins_t bins = rsum_bins(max_abs, n);
+ *     rsum_t sum = rsum_zero();
+ *     #pragma omp parallel for reduction(rsum:sum)
+ *     for (int i = 0; i < n; i++)
+ *         rsum_add(&sum, &bins, x[i]);
+ *
+ *     double total = rsum_result(&sum);
+ *
+ * The same works in target regions (map sum with tofrom).
+ *
+ * Each bin keeps about 52 - log2(n) bits, so with the default of three
+ * bins the error relative to n * max_abs is about 2^-(3 * (51 - log2(n))).
+ *
+ * Note! The rounding trick needs IEEE arithmetic in round-to-nearest
+ * mode, do not compile with -ffast-math.
+ */
+
+#ifndef REPRODUCIBLE_SUM_H
+#define REPRODUCIBLE_SUM_H
+
+#include <math.h>
+
+#if defined(__FAST_MATH__)
+#error "reproducible_sum.h does not work with -ffast-math"
+#endif
+
+#ifndef RSUM_FOLD
+#define RSUM_FOLD 3
+#endif
+
+// Rounding constants of the bins, from the largest to the smallest
+typedef struct {
+    double m[RSUM_FOLD];
+} rsum_bins_t;
+
+// Exact partial sums of the bins
+typedef struct {
+    double s[RSUM_FOLD];
+} rsum_t;
+
+#pragma omp declare target
+
+static inline
+rsum_t rsum_zero(void)
+{
+    rsum_t sum;
+    for (int k = 0; k < RSUM_FOLD; k++) {
+        sum.s[k] = 0.0;
+    }
+    return sum;
+}
+
+static inline
+void rsum_add(rsum_t *sum, const rsum_bins_t *bins, double x)
+{
+    for (int k = 0; k < RSUM_FOLD; k++) {
+        // Round x to a multiple of the unit in the last place of m
+        double hi = (bins->m[k] + x) - bins->m[k];
+        sum->s[k] += hi;
+        x -= hi;
+    }
+}
+
+static inline
+void rsum_combine(rsum_t *out, const rsum_t *in)
+{
+    for (int k = 0; k < RSUM_FOLD; k++) {
+        out->s[k] += in->s[k];
+    }
+}
+
+#pragma omp end declare target
+
+#pragma omp declare reduction(rsum : rsum_t : rsum_combine(&omp_out, &omp_in)) \
+    initializer(omp_priv = rsum_zero())
+
+// Bins for summing n values with absolute values at most max_abs
+static inline
+rsum_bins_t rsum_bins(double max_abs, long n)
+{
+    int log2n = 0;
+    while ((1L << log2n) < n) {
+        log2n++;
+    }
+
+    // All values of the first bin are below 2^e
+    int e;
+    frexp(max_abs, &e);
+
+    rsum_bins_t bins;
+    for (int k = 0; k < RSUM_FOLD; k++) {
+        // m = 1.5 * 2^e with n * 2^e < 2^(e_m - 1): m + x stays in the
+        // binade of m, and the sum of n rounded parts stays below 2^(e_m + 1)
+        e += log2n + 1;
+        bins.m[k] = ldexp(1.5, e);
+        // The remainders are at most half a unit in the last place of m
+        e -= 52;
+    }
+    return bins;
+}
+
+// Sum of all bins, always added in the same order
+static inline
+double rsum_result(const rsum_t *sum)
+{
+    double total = 0.0;
+    for (int k = RSUM_FOLD - 1; k >= 0; k--) {
+        total += sum->s[k];
+    }
+    return total;
+}
+
+#endif
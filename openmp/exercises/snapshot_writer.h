@@ -0,0 +1,106 @@
+/*
+ * SPDX-FileCopyrightText: 2026 CSC - IT Center for Science Ltd. <www.csc.fi>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/*
+ * Streaming snapshot writer
+ *
+ * Instead of a `target update` of the whole array followed by write_array(),
+ * the array is copied to the host in bands of rows through two band-sized
+ * pinned staging buffers (see heat_staging.h), and each band is written
+ * while the next one is being copied:
+ *
+ *     snapshot_writer_t writer;
+ *     snapshot_writer_init(&writer, 256);   // rows per band
+ *
+ *     // from the thread launching the kernels, blocking
+ *     snapshot_write(&writer, "u.bin", u, nx, ny, Lx, Ly);
+ *
+ *     // or without waiting, e.g. inside `parallel` + `single` with other
+ *     // threads available for the tasks
+ *     snapshot_write_tasks(&writer, "u.bin", u, nx, ny, Lx, Ly);
+ *     ...
+ *     snapshot_writer_free(&writer);
+ *
+ * u must be mapped to the device. The host staging memory is two bands, not
+ * the grid: the host copy of u is not touched. The array is first copied to
+ * a snapshot buffer on the device, which is the only step depending on
+ * u[0:nx*ny], so the kernels overwriting u wait for that copy but not for
+ * the bands to be copied to the host or written. The snapshot buffer costs
+ * a second copy of the array in device memory (in host memory without a
+ * device). Snapshots are written one at a time. The file format is the
+ * same as in write_array().
+ */
+
+#ifndef SNAPSHOT_WRITER_H
+#define SNAPSHOT_WRITER_H
+
+#include <stdio.h>
+#include <string.h>
+#include "heat_staging.h"
+
+typedef struct {
+    int band_rows;
+    size_t nx;              // row length the staging buffers were sized for
+    heat_staging_t staging;
+} snapshot_writer_t;
+
+
+static
+void snapshot_writer_init(snapshot_writer_t *w, const int band_rows)
+{
+    memset(w, 0, sizeof(*w));
+    w->band_rows = band_rows > 0 ? band_rows : 1;
+}
+
+
+// Create the tasks copying and writing u, without waiting for them
+static
+void snapshot_write_tasks(snapshot_writer_t *w, const char *filename, double *u,
+                          const size_t nx, const size_t ny, const double Lx, const double Ly)
+{
+    // The staging buffers hold one band each, sized at the first snapshot
+    if (w->nx != nx) {
+        if (w->nx != 0) {
+            #pragma omp taskwait
+            heat_staging_free(&w->staging);
+        }
+        heat_staging_init(&w->staging, w->band_rows * nx * sizeof(double));
+        w->nx = nx;
+    }
+
+    double *u_dev = u;
+    #pragma omp target data use_device_ptr(u_dev)
+    {
+        heat_staging_write(&w->staging, filename, u, u_dev, nx, ny, Lx, Ly);
+    }
+}
+
+
+// Copy and write u, returning when the file has been written
+static inline
+int snapshot_write(snapshot_writer_t *w, const char *filename, double *u,
+                   const size_t nx, const size_t ny, const double Lx, const double Ly)
+{
+    TRACE_PUSH(__func__);
+    snapshot_write_tasks(w, filename, u, nx, ny, Lx, Ly);
+    #pragma omp taskwait
+    const int error = w->staging.error;
+    w->staging.error = 0;
+    TRACE_POP();
+    return error;
+}
+
+
+static
+void snapshot_writer_free(snapshot_writer_t *w)
+{
+    if (w->nx != 0) {
+        heat_staging_free(&w->staging);
+    }
+    memset(w, 0, sizeof(*w));
+}
+
+#endif
@@ -0,0 +1,186 @@
+/*
+ * SPDX-FileCopyrightText: 2026 CSC - IT Center for Science Ltd. <www.csc.fi>
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+/*
+ * Lightweight CPU tracer behind TRACE_PUSH/TRACE_POP
+ *
+ * Compile with -DTRACE -DTRACE_CPU and run with
+ *
+ *     TRACE_CPU_OUTPUT=trace.json ./heat.x
+ *
+ * Each host thread records its ranges into its own buffer, so no locking is
+ * needed while recording. The buffers are registered once per thread with
+ * an atomic push to a global list, and written out at exit in the Chrome
+ * trace event format, which can be opened in https://ui.perfetto.dev or
+ * chrome://tracing.
+ *
+ * Without TRACE_CPU_OUTPUT the tracer is disabled and TRACE_PUSH/TRACE_POP
+ * cost a single predictable branch.
+ *
+ * Note! The range names are stored as pointers, so they must be string
+ * literals or otherwise live until the end of the program (e.g. __func__).
+ */
+
+#ifndef TRACE_CPU_H
+#define TRACE_CPU_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#define TRACE_CPU_MAX_DEPTH 64
+#define TRACE_CPU_MAX_EVENTS 65536
+
+typedef struct {
+    const char *name;
+    double start;      // microseconds since the start of tracing
+    double duration;   // microseconds
+} trace_cpu_event_t;
+
+typedef struct trace_cpu_buffer {
+    struct trace_cpu_buffer *next;
+    int tid;
+    int depth;
+    int nevent;
+    long dropped;
+    const char *open_names[TRACE_CPU_MAX_DEPTH];
+    double open_starts[TRACE_CPU_MAX_DEPTH];
+    trace_cpu_event_t events[TRACE_CPU_MAX_EVENTS];
+} trace_cpu_buffer_t;
+
+// The state is shared between all translation units including this header
+__attribute__((weak)) int trace_cpu_state = -1;  // -1 = not initialized, 0 = off, 1 = on
+__attribute__((weak)) int trace_cpu_nthread = 0;
+__attribute__((weak)) double trace_cpu_t0 = 0.0;
+__attribute__((weak)) trace_cpu_buffer_t *trace_cpu_buffers = NULL;
+__attribute__((weak)) __thread trace_cpu_buffer_t *trace_cpu_buffer = NULL;
+
+
+static inline
+double trace_cpu_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return 1.0e6 * ts.tv_sec + 1.0e-3 * ts.tv_nsec;
+}
+
+
+static inline
+void trace_cpu_dump(void)
+{
+    const char *filename = getenv("TRACE_CPU_OUTPUT");
+    FILE *file = fopen(filename, "w");
+    if (file == NULL) {
+        perror("Failed to open trace file");
+        return;
+    }
+
+    const int pid = getpid();
+    int first = 1;
+    fprintf(file, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+    for (trace_cpu_buffer_t *b = __atomic_load_n(&trace_cpu_buffers, __ATOMIC_ACQUIRE);
+         b != NULL; b = b->next) {
+        fprintf(file, "%s{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": %d, \"tid\": %d, "
+                      "\"args\": {\"name\": \"host thread %d\"}}",
+                first ? "" : ",\n", pid, b->tid, b->tid);
+        first = 0;
+        const int nevent = __atomic_load_n(&b->nevent, __ATOMIC_ACQUIRE);
+        for (int i = 0; i < nevent; i++) {
+            const trace_cpu_event_t *e = &b->events[i];
+            fprintf(file, ",\n{\"name\": \"%s\", \"ph\": \"X\", \"pid\": %d, \"tid\": %d, "
+                          "\"ts\": %.3f, \"dur\": %.3f}",
+                    e->name, pid, b->tid, e->start, e->duration);
+        }
+        if (b->dropped > 0) {
+            fprintf(stderr, "trace_cpu: thread %d dropped %ld ranges (buffer full)\n",
+                    b->tid, b->dropped);
+        }
+    }
+    fprintf(file, "\n]}\n");
+    fclose(file);
+    printf("CPU trace written to %s\n", filename);
+}
+
+
+static inline
+int trace_cpu_enabled(void)
+{
+    int state = __atomic_load_n(&trace_cpu_state, __ATOMIC_ACQUIRE);
+    if (__builtin_expect(state >= 0, 1)) return state;
+
+    // First call: check the environment, only one thread registers the dump
+    const char *filename = getenv("TRACE_CPU_OUTPUT");
+    int enabled = filename != NULL && *filename != '\0';
+    int expected = -1;
+    if (__atomic_compare_exchange_n(&trace_cpu_state, &expected, -2, 0,
+                                    __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        if (enabled) {
+            trace_cpu_t0 = trace_cpu_now();
+            atexit(trace_cpu_dump);
+        }
+        __atomic_store_n(&trace_cpu_state, enabled, __ATOMIC_RELEASE);
+    }
+    while ((state = __atomic_load_n(&trace_cpu_state, __ATOMIC_ACQUIRE)) < 0) { }
+    return state;
+}
+
+
+static inline
+trace_cpu_buffer_t *trace_cpu_thread_buffer(void)
+{
+    trace_cpu_buffer_t *b = trace_cpu_buffer;
+    if (__builtin_expect(b != NULL, 1)) return b;
+
+    b = (trace_cpu_buffer_t*)calloc(1, sizeof(trace_cpu_buffer_t));
+    if (b == NULL) return NULL;
+    b->tid = __atomic_fetch_add(&trace_cpu_nthread, 1, __ATOMIC_RELAXED);
+
+    // Lock-free push to the list of all buffers
+    b->next = __atomic_load_n(&trace_cpu_buffers, __ATOMIC_RELAXED);
+    while (!__atomic_compare_exchange_n(&trace_cpu_buffers, &b->next, b, 1,
+                                        __ATOMIC_RELEASE, __ATOMIC_RELAXED)) { }
+
+    trace_cpu_buffer = b;
+    return b;
+}
+
+
+static inline
+void trace_cpu_push(const char *name)
+{
+    if (!trace_cpu_enabled()) return;
+    trace_cpu_buffer_t *b = trace_cpu_thread_buffer();
+    if (b == NULL) return;
+    if (b->depth < TRACE_CPU_MAX_DEPTH) {
+        b->open_names[b->depth] = name;
+        b->open_starts[b->depth] = trace_cpu_now() - trace_cpu_t0;
+    }
+    b->depth++;
+}
+
+
+static inline
+void trace_cpu_pop(void)
+{
+    if (!trace_cpu_enabled()) return;
+    trace_cpu_buffer_t *b = trace_cpu_thread_buffer();
+    if (b == NULL || b->depth == 0) return;
+    b->depth--;
+    if (b->depth >= TRACE_CPU_MAX_DEPTH) return;
+    if (b->nevent == TRACE_CPU_MAX_EVENTS) {
+        b->dropped++;
+        return;
+    }
+    trace_cpu_event_t *e = &b->events[b->nevent];
+    e->name = b->open_names[b->depth];
+    e->start = b->open_starts[b->depth];
+    e->duration = trace_cpu_now() - trace_cpu_t0 - e->start;
+    // Publish the event for the dump at exit
+    __atomic_store_n(&b->nevent, b->nevent + 1, __ATOMIC_RELEASE);
+}
+
+#endif